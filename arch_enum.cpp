@@ -21,59 +21,93 @@
  * IN THE SOFTWARE.
  */
 
-#include <intrin.h>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <unordered_map>
 
 #include "cpuid.hpp"
 #include "msr.hpp"
+#include "msr_sweep.hpp"
+#include "lxx_parser.hpp"
+#include "report.hpp"
+#include "snapshot.hpp"
+#include "snapshot_diff.hpp"
+#include "field_ref.hpp"
+#include "field_decode.hpp"
+#include "cpu_fingerprint.hpp"
+#include "cpuid_profiler.hpp"
+#include "msr_latency.hpp"
+#include "structured_output.hpp"
+#include "msr_watch.hpp"
+#include "cpu_frequency.hpp"
+#include "cpu_topology.hpp"
+#include "hybrid_cores.hpp"
 
 void print_cpuid( int function_id, int subfunction_id = 0 )
 {
-    printf( "## CPUID [%lX.%lX]\n", function_id, subfunction_id );
     cpu_query cpuid( function_id, subfunction_id );
+    print_cpuid( cpuid );
+}
 
-    if ( cpuid.get_schema().empty() )
-        printf( "%s |=> LEAF DOES NOT EXIST / INVALID / UNSUPPORTED\n", std::string( 15, ' ' ).c_str() );
+void enum_cpuid_leaves()
+{
+    report_writer writer( stdout );
+    for_each_cpuid_leaf( [ & ] ( cpu_query& leaf ) { write_cpuid( writer, leaf ); } );
+}
 
-    for ( auto& [name, idx] : cpuid.get_schema() )
+const char* describe_msr_state( const snapshot_msr_lookup& state, char( &buffer )[ 32 ] )
+{
+    switch ( state.status )
     {
-        auto& cpuid_reg = cpuid[ name ];
-        printf( "%15c[%s] {%Xh}\n", ' ', name.c_str(), cpuid_reg.data );
-
-        for ( auto& reg : idx.fields )
-        {
-            auto field_value = cpuid_reg( { reg.bit_start, reg.bit_end } );
-            printf( "%70s {%5llu:%-5llu} %15s %llXh\n",
-                    reg.name.c_str(),
-                    reg.bit_start,
-                    reg.bit_end,
-                    "=",
-                    field_value.as<uint64_t>() );
-        }
+        case msr_ok: snprintf( buffer, sizeof( buffer ), "{%llXh}", static_cast< unsigned long long >( state.value ) ); return buffer;
+        case msr_gp_fault: return "#GP(0)";
+        case msr_no_access: return "NO ACCESS";
+        default: return "NOT SWEPT";
     }
-    // don't judge
-    printf( "\n%s\n\n", std::string( 128, '-' ).c_str() );
 }
 
-void enum_cpuid_leaves()
+void print_latency_histogram( const char* label, const latency_histogram& histogram )
 {
-    cpu_query tmp( initial_cpuid_function_id );
-    [[maybe_unused]] int32_t max_cpuid_leaf = tmp.get_bit_range( "eax", 0, 31 );
+    printf( "%15c%s: %llu reads, min %llu p50 %llu p90 %llu p99 %llu p99.9 %llu max %llu cycles\n", ' ', label,
+            static_cast< unsigned long long >( histogram.total ),
+            static_cast< unsigned long long >( histogram.total ? histogram.min : 0 ),
+            static_cast< unsigned long long >( histogram.value_at( 50.0 ) ),
+            static_cast< unsigned long long >( histogram.value_at( 90.0 ) ),
+            static_cast< unsigned long long >( histogram.value_at( 99.0 ) ),
+            static_cast< unsigned long long >( histogram.value_at( 99.9 ) ),
+            static_cast< unsigned long long >( histogram.max ) );
+}
 
-    std::unordered_map<int, int> sub_leaves_map = { {7, 3}, {0x0d, 3}, {0x12, 3}, {0x10, 4}, {0x17, 4}, {0x18, 2}, {0x1b, 2}, {0x1d, 2}, {0x14, 2}, };
+void print_snapshot_diff( const snapshot_diff& diff )
+{
+    static const char* kinds[] = { "added", "removed", "changed" };
 
-    for ( auto it = initial_cpuid_function_id; it <= max_cpuid_leaf /* can also test with to see behavior => max_cpuid_function_id*/; it++ )
+    for ( const auto& change : diff.cpuid )
     {
-        const int sub_leaves = sub_leaves_map.contains( it ) ? sub_leaves_map[ it ] : 1;
+        printf( "## CPU [%u] CPUID [%X.%X] [%s] {%Xh} => {%Xh} (%s)\n",
+                change.cpu, change.leaf, change.subleaf, cpu_query::to_string( change.reg ),
+                change.before, change.after, kinds[ change.kind ] );
 
-        for ( auto sub = 0; sub < sub_leaves; sub++ )
-            print_cpuid( it, sub );
+        for ( const auto& field : diff.fields_of( change ) )
+            printf( "%70.*s {%5u:%-5u} %15s %llXh => %llXh\n", int( field.name.size() ), field.name.data(),
+                    field.bit_start, field.bit_end, "=", static_cast< unsigned long long >( field.before ), static_cast< unsigned long long >( field.after ) );
     }
 
-    for ( auto it = ext_cpuid_function_id; it < ext_cpuid_function_id_max; it++ )
-        print_cpuid( it );
+    for ( const auto& change : diff.msrs )
+    {
+        char before[ 32 ], after[ 32 ];
+        const auto& schema = find_msr_schema( change.index );
+        const char* name = schema.empty() ? "" : schema.begin()->first.c_str();
+
+        printf( "## CPU [%u] MSR [%s | %X] %s => %s (%s)\n", change.cpu, name, change.index,
+                describe_msr_state( change.before, before ), describe_msr_state( change.after, after ), kinds[ change.kind ] );
+
+        for ( const auto& field : diff.fields_of( change ) )
+            printf( "%70.*s {%5u:%-5u} %15s %llXh => %llXh\n", int( field.name.size() ), field.name.data(),
+                    field.bit_start, field.bit_end, "=", static_cast< unsigned long long >( field.before ), static_cast< unsigned long long >( field.after ) );
+    }
 }
 
 auto get_cpu_brand()
@@ -93,8 +127,283 @@ auto get_cpu_brand()
     return brand_name;
 }
 
+// "0-7,16,18"
+//
+const char* describe_cpu_set( const cpu_set& cpus, std::string& buffer )
+{
+    buffer.clear();
+    const auto list = cpus.to_vector();
+    for ( std::size_t i = 0; i < list.size(); )
+    {
+        std::size_t j = i;
+        while ( j + 1 < list.size() && list[ j + 1 ] == list[ j ] + 1 )
+            ++j;
+
+        if ( !buffer.empty() )
+            buffer += ',';
+        buffer += std::to_string( list[ i ] );
+        if ( j > i )
+            buffer += '-' + std::to_string( list[ j ] );
+        i = j + 1;
+    }
+
+    return buffer.c_str();
+}
+
+void print_topology_node( const topology_node& node, int depth )
+{
+    std::string cpus;
+    printf( "%*s## %s [%X] cpus %s\n", depth * 4, "", topology_level_name( node.level ), node.id, describe_cpu_set( node.cpus, cpus ) );
+    for ( const auto& child : node.children )
+        print_topology_node( child, depth + 1 );
+}
+
+void print_topology( const cpu_topology& topology )
+{
+    for ( const auto& package : topology.packages )
+        print_topology_node( package, 0 );
+
+    static constexpr const char* cache_types[] = { "null", "data", "instruction", "unified" };
+    for ( const auto& cache : topology.caches )
+    {
+        std::string cpus;
+        printf( "## L%u %s [%X] %llu KB, %u-way, %u B lines, cpus %s\n", cache.level, cache_types[ cache.type & 3 ], cache.id,
+                static_cast< unsigned long long >( cache.size / 1024 ), cache.ways, cache.line_size, describe_cpu_set( cache.cpus, cpus ) );
+    }
+}
+
 int main( int argc, char** argv, char** envp )
 {
+    // [[Sweep every MSR range on all cpus in parallel and print one report per cpu]]
+    //
+    // An optional probe map file skips indices that #GP'd on a previous run of the same cpu/microcode.
+    //
+    if ( argc > 1 && !strcmp( argv[ 1 ], "--msr" ) )
+    {
+        const auto table = argc > 2 ? sweep_msrs_cached( argv[ 2 ] ) : sweep_msrs();
+        report_writer writer( stdout );
+        for ( const auto& result : table.cpus )
+            write_msr_report( writer, result );
+
+        return 0;
+    }
+
+    // [[Convert an archived .lxx execution report into a binary snapshot]]
+    //
+    if ( argc > 3 && !strcmp( argv[ 1 ], "--import-lxx" ) )
+    {
+        snapshot_builder snapshot;
+        if ( !import_lxx( argv[ 2 ], snapshot ) || !snapshot.write( argv[ 3 ] ) )
+        {
+            printf( "failed to convert %s\n", argv[ 2 ] );
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // [[Field-level diff of two snapshots]]
+    //
+    if ( argc > 3 && !strcmp( argv[ 1 ], "--diff" ) )
+    {
+        const snapshot_file before( argv[ 2 ] );
+        const snapshot_file after( argv[ 3 ] );
+        if ( !before.valid() || !after.valid() )
+        {
+            printf( "failed to load %s\n", before.valid() ? argv[ 3 ] : argv[ 2 ] );
+            return 1;
+        }
+
+        print_snapshot_diff( diff_snapshots( before.view, after.view ) );
+        return 0;
+    }
+
+    // [[Capture CPUID + MSRs of every cpu into a binary snapshot]]
+    //
+    if ( argc > 2 && !strcmp( argv[ 1 ], "--snapshot" ) )
+    {
+        auto snapshot = capture_snapshot();
+        if ( !snapshot.write( argv[ 2 ] ) )
+        {
+            printf( "failed to write %s\n", argv[ 2 ] );
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // [[Fingerprint of this machine, or of a stored snapshot]]
+    //
+    if ( argc > 1 && !strcmp( argv[ 1 ], "--fingerprint" ) )
+    {
+        cpu_fingerprint fp;
+        if ( argc > 2 )
+        {
+            const snapshot_file snapshot( argv[ 2 ] );
+            if ( !snapshot.valid() )
+            {
+                printf( "failed to load %s\n", argv[ 2 ] );
+                return 1;
+            }
+
+            fp = fingerprint_snapshot( snapshot.view );
+        }
+        else
+            fp = fingerprint_cpu();
+
+        printf( "%016llx%016llx\n", static_cast< unsigned long long >( fp.hi ), static_cast< unsigned long long >( fp.lo ) );
+        return 0;
+    }
+
+    // [[CPUID latency per leaf, in TSC cycles]]
+    //
+    if ( argc > 1 && !strcmp( argv[ 1 ], "--profile-cpuid" ) )
+    {
+        const std::size_t samples = argc > 2 ? strtoul( argv[ 2 ], nullptr, 0 ) : 1000;
+        for ( const auto& leaf : profile_cpuid_leaves( samples ? samples : 1000 ) )
+            printf( "## CPUID [%X.%X] min %llu median %llu p99 %llu max %llu cycles\n", leaf.leaf, leaf.subleaf,
+                    static_cast< unsigned long long >( leaf.cycles.min ), static_cast< unsigned long long >( leaf.cycles.median ),
+                    static_cast< unsigned long long >( leaf.cycles.p99 ), static_cast< unsigned long long >( leaf.cycles.max ) );
+
+        return 0;
+    }
+
+    // [[MSR read latency histograms and outliers per cpu]]
+    //
+    if ( argc > 1 && !strcmp( argv[ 1 ], "--msr-latency" ) )
+    {
+        const std::size_t samples = argc > 2 ? strtoul( argv[ 2 ], nullptr, 0 ) : 16;
+        for ( const auto& result : profile_msr_latency( {}, samples ) )
+        {
+            printf( "## CPU [%u]\n", result.cpu );
+            print_latency_histogram( "ok", result.ok_reads );
+            print_latency_histogram( "#GP(0)", result.faulted_reads );
+
+            for ( const auto& record : msr_latency_outliers( result ) )
+            {
+                const auto& schema = find_msr_schema( record.index );
+                printf( "%15c[%s | %X] %s median %llu p99 %llu cycles (outlier)\n", ' ',
+                        schema.empty() ? "" : schema.begin()->first.c_str(), record.index,
+                        record.status == msr_ok ? "ok" : "#GP(0)",
+                        static_cast< unsigned long long >( record.cycles.median ),
+                        static_cast< unsigned long long >( record.cycles.p99 ) );
+            }
+        }
+
+        return 0;
+    }
+
+    // [[CPUID + MSR records as NDJSON or CSV, from this machine or a stored snapshot]]
+    //
+    if ( argc > 1 && ( !strcmp( argv[ 1 ], "--ndjson" ) || !strcmp( argv[ 1 ], "--csv" ) ) )
+    {
+        report_writer writer( stdout );
+        record_emitter emitter( writer, !strcmp( argv[ 1 ], "--csv" ) ? record_csv : record_ndjson );
+        if ( argc > 2 )
+        {
+            const snapshot_file snapshot( argv[ 2 ] );
+            if ( !snapshot.valid() )
+            {
+                fprintf( stderr, "failed to load %s\n", argv[ 2 ] );
+                return 1;
+            }
+
+            emit_snapshot( emitter, snapshot.view );
+        }
+        else
+            emit_live( emitter );
+
+        return 0;
+    }
+
+    // [[Sample the watch MSR set on every cpu: --watch [interval in us] [seconds]]]
+    //
+    if ( argc > 1 && !strcmp( argv[ 1 ], "--watch" ) )
+    {
+        msr_watch_options options;
+        if ( argc > 2 )
+            options.interval = std::chrono::microseconds( strtoul( argv[ 2 ], nullptr, 0 ) );
+        const auto duration = std::chrono::seconds( argc > 3 ? strtoul( argv[ 3 ], nullptr, 0 ) : 1 );
+
+        msr_watch watch( options );
+        report_writer writer( stdout );
+        const auto print = [ & ] ( uint32_t cpu, const msr_sample& s )
+        {
+            const auto& schema = find_msr_schema( s.index );
+            writer.put( "## CPU [" ).dec( cpu ).put( "] " ).dec( s.tsc ).put( " [" )
+                  .put( schema.empty() ? "" : schema.begin()->first ).put( " | " ).hex( s.index ).put( "] " );
+            if ( s.status == msr_ok )
+                writer.put( '{' ).hex( s.value ).put( "h}\n" );
+            else
+                writer.put( s.status == msr_gp_fault ? "#GP(0)\n" : "NO ACCESS\n" );
+        };
+
+        const auto deadline = std::chrono::steady_clock::now() + duration;
+        watch.start();
+        while ( watch.sampling() && std::chrono::steady_clock::now() < deadline )
+        {
+            watch.drain( print );
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        }
+
+        watch.stop();
+        watch.drain( print );
+        writer.flush();
+
+        if ( const auto dropped = watch.dropped() )
+            fprintf( stderr, "%llu samples dropped\n", static_cast< unsigned long long >( dropped ) );
+
+        return 0;
+    }
+
+    // [[Effective frequency and C0 residency per cpu: --frequency [interval in ms] [seconds]]]
+    //
+    if ( argc > 1 && !strcmp( argv[ 1 ], "--frequency" ) )
+    {
+        frequency_options options;
+        options.tsc = get_tsc_frequency();
+        if ( argc > 2 )
+            options.interval = std::chrono::milliseconds( std::max( 1ul, strtoul( argv[ 2 ], nullptr, 0 ) ) );
+        if ( argc > 3 )
+            options.duration = std::chrono::seconds( strtoul( argv[ 3 ], nullptr, 0 ) );
+
+        static constexpr const char* sources[] = { "unknown", "cpuid 15h", "cpuid 16h", "calibrated" };
+        printf( "## TSC %llu MHz (%s)\n", static_cast< unsigned long long >( options.tsc.hz / 1000000 ), sources[ options.tsc.source ] );
+
+        for ( const auto& series : collect_frequency( options ) )
+        {
+            printf( "## CPU [%u]%s\n", series.cpu, series.points.empty() ? " NO ACCESS" : "" );
+            for ( const auto& point : series.points )
+                printf( "%15c%llu avg %6.0f MHz busy %6.0f MHz c0 %5.1f%%\n", ' ', static_cast< unsigned long long >( point.tsc ),
+                        point.avg_mhz, point.busy_mhz, point.c0_percent );
+        }
+
+        return 0;
+    }
+
+    // [[Package/die/core/thread tree and cache sharing sets]]
+    //
+    if ( argc > 1 && !strcmp( argv[ 1 ], "--topology" ) )
+    {
+        print_topology( build_cpu_topology() );
+        return 0;
+    }
+
+    // [[Cpus per core type (P-core/E-core) on hybrid parts]]
+    //
+    if ( argc > 1 && !strcmp( argv[ 1 ], "--hybrid" ) )
+    {
+        const auto cores = classify_hybrid_cores();
+        printf( "## HYBRID [%s]\n", cores.hybrid ? "yes" : "no" );
+
+        std::string cpus, primary;
+        for ( const auto& group : cores.groups )
+            printf( "## %s [%X] model %X, %zu cores, cpus %s, one per core %s\n", core_type_name( group.core_type ), group.core_type,
+                    group.native_model_id, group.cores.size(), describe_cpu_set( group.cpus, cpus ), describe_cpu_set( group.primary_threads, primary ) );
+
+        return 0;
+    }
+
     // [[Example for KM display of all MSRs that have a schema in the list]]
     //
     // for ( const auto& index : msr_schema_list | std::views::keys )
@@ -136,6 +445,9 @@ int main( int argc, char** argv, char** envp )
     auto field = cpu.get_field( "eax", { 16,23 } );
     printf( "%s %Xh\n", field.field_name.c_str(), field.value );
 
+    cpu_query leaf_1( 0x01 );
+    printf( "avx %u\n", cpuid_field_ref<0x01, "ecx", "avx">::get( leaf_1 ) );
+
     getchar();
 
     return 0;
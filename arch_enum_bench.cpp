@@ -0,0 +1,255 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+// Benchmarks for the hot paths: CPUID/MSR query construction, field lookup and decode, full leaf
+// enumeration, report formatting and .lxx parsing. Prints a table, and with --json <path> also
+// writes the results as JSON so runs of different releases can be compared.
+//
+//     arch_enum_bench [demo_logs directory] [--json results.json]
+//
+// MSR benchmarks read from an in-memory backend filled from a demo log, so they measure the
+// library's own overhead and run without a driver or root.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "cpuid.hpp"
+#include "cpuid_cache.hpp"
+#include "msr.hpp"
+#include "msr_sweep.hpp"
+#include "field_ref.hpp"
+#include "field_decode.hpp"
+#include "lxx_parser.hpp"
+#include "mapped_file.hpp"
+#include "report.hpp"
+
+struct bench_result
+{
+    std::string name;
+    uint64_t iterations;
+    double ns_per_op;
+    double mb_per_s;        // 0 unless the benchmark consumes input bytes
+};
+
+static volatile uint64_t bench_sink;
+
+// Calls fn until at least min_seconds have elapsed; each call performs ops operations and
+// consumes bytes bytes of input.
+//
+template <typename Fn>
+bench_result run_bench( const char* name, Fn&& fn, uint64_t ops = 1, uint64_t bytes = 0, double min_seconds = 0.25 )
+{
+    using clock = std::chrono::steady_clock;
+
+    fn();
+
+    uint64_t calls = 0;
+    const auto start = clock::now();
+    double elapsed = 0;
+
+    do
+    {
+        for ( int i = 0; i < 16; ++i )
+            fn();
+
+        calls += 16;
+        elapsed = std::chrono::duration<double>( clock::now() - start ).count();
+    } while ( elapsed < min_seconds );
+
+    const uint64_t iterations = calls * ops;
+    return { name, iterations, elapsed * 1e9 / double( iterations ), bytes ? double( calls * bytes ) / elapsed / 1e6 : 0 };
+}
+
+// MSR values of one cpu of a demo log, served from memory.
+//
+struct table_msr_backend : msr_backend
+{
+    std::vector<msr_record> records;
+
+    e_msr_status read( uint32_t, uint32_t index, uint64_t& value ) override
+    {
+        const auto it = std::lower_bound( records.begin(), records.end(), index, [] ( const msr_record& r, uint32_t i ) { return r.index < i; } );
+        if ( it == records.end() || it->index != index )
+            return msr_gp_fault;
+
+        value = it->value;
+        return it->status;
+    }
+};
+
+static FILE* open_null_output()
+{
+#if defined( _WIN32 )
+    return fopen( "NUL", "w" );
+#else
+    return fopen( "/dev/null", "w" );
+#endif
+}
+
+static void write_json( const char* path, const std::vector<bench_result>& results )
+{
+    FILE* out = fopen( path, "w" );
+    if ( !out )
+    {
+        printf( "failed to write %s\n", path );
+        return;
+    }
+
+    fprintf( out, "{\n  \"benchmarks\": [\n" );
+    for ( std::size_t i = 0; i < results.size(); ++i )
+    {
+        const auto& r = results[ i ];
+        fprintf( out, "    { \"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, \"mb_per_s\": %.3f }%s\n",
+                 r.name.c_str(), static_cast< unsigned long long >( r.iterations ), r.ns_per_op, r.mb_per_s,
+                 i + 1 < results.size() ? "," : "" );
+    }
+    fprintf( out, "  ]\n}\n" );
+    fclose( out );
+}
+
+int main( int argc, char** argv )
+{
+    std::string logs = "demo_logs";
+    const char* json_path = nullptr;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( !strcmp( argv[ i ], "--json" ) && i + 1 < argc )
+            json_path = argv[ ++i ];
+        else
+            logs = argv[ i ];
+    }
+
+    const std::string lxx_paths[] = {
+        logs + "/13900k_msr_log_20230804T170105.lxx",
+        logs + "/vmware_msr_log_20230804T172348.lxx"
+    };
+
+    std::vector<bench_result> results;
+    FILE* null_out = open_null_output();
+    if ( !null_out )
+    {
+        printf( "failed to open the null device for the report benchmarks\n" );
+        return 1;
+    }
+
+    // [[CPUID]]
+    //
+    results.push_back( run_bench( "cpu_query/leaf_0", [] { bench_sink = cpu_query( 0x00 ).registers()[ 0 ]; } ) );
+    results.push_back( run_bench( "cpu_query/leaf_1", [] { bench_sink = cpu_query( 0x01 ).registers()[ 0 ]; } ) );
+    results.push_back( run_bench( "cpu_query/leaf_7", [] { bench_sink = cpu_query( 0x07 ).registers()[ 1 ]; } ) );
+    results.push_back( run_bench( "cpu_query/leaf_80000002", [] { bench_sink = cpu_query( 0x80000002 ).registers()[ 0 ]; } ) );
+    results.push_back( run_bench( "cpu_query/leaf_7_cached", [] { bench_sink = cpu_query( 0x07, 0, process_cpuid_cache() ).registers()[ 1 ]; } ) );
+
+    cpu_query leaf_1( 0x01 );
+    results.push_back( run_bench( "field/by_name", [ & ] { bench_sink = leaf_1.get_field( "eax", "family" ); } ) );
+    results.push_back( run_bench( "field/by_range", [ & ] { bench_sink = leaf_1.get_field( "eax", { 8, 15 } ).value; } ) );
+    results.push_back( run_bench( "field/compile_time", [ & ] { bench_sink = cpuid_field_ref<0x01, "eax", "family">::get( leaf_1 ); } ) );
+    results.push_back( run_bench( "field/get_bit_range", [ & ] { bench_sink = leaf_1.get_bit_range( "eax", 8, 15 ); } ) );
+
+    // Captured once so report/cpuid times formatting only, not CPUID execution.
+    //
+    std::vector<cpu_query> leaves;
+    for_each_cpuid_leaf( [ & ] ( cpu_query& leaf ) { leaves.push_back( leaf ); } );
+    results.push_back( run_bench( "enum_cpuid_leaves", [] { for_each_cpuid_leaf( [] ( cpu_query& leaf ) { bench_sink = leaf.registers()[ 0 ]; } ); } ) );
+    report_writer cpuid_writer( null_out );
+    results.push_back( run_bench( "report/cpuid", [ & ]
+    {
+        for ( auto& leaf : leaves )
+            write_cpuid( cpuid_writer, leaf );
+        cpuid_writer.flush();
+    }, leaves.size() ) );
+
+    // [[MSR]]
+    //
+    for ( const auto& path : lxx_paths )
+    {
+        const mapped_file file( path );
+        if ( !file.is_open() )
+        {
+            printf( "skipping %s (not found)\n", path.c_str() );
+            continue;
+        }
+
+        const std::string tag = path.find( "13900k" ) != std::string::npos ? "13900k" : "vmware";
+        const auto bytes = file.bytes();
+
+        results.push_back( run_bench( ( "lxx_parse/" + tag ).c_str(), [ & ]
+        {
+            lxx_parser parser( bytes );
+            lxx_record record{};
+            uint64_t count = 0;
+            while ( parser.next( record ) )
+                ++count;
+            bench_sink = count;
+        }, 1, bytes.size() ) );
+
+        // cpu 0 of the log, used as the backend for the msr_query and report benchmarks
+        //
+        table_msr_backend backend;
+        {
+            lxx_parser parser( bytes );
+            lxx_record record{};
+            while ( parser.next( record ) && record.cpu == 0 )
+                backend.records.push_back( { record.index, record.status, record.value } );
+        }
+
+        const auto indices = msr_sweep_indices( msr_sweep_options{} );
+        results.push_back( run_bench( ( "msr_query/" + tag ).c_str(), [ & ]
+        {
+            for ( const auto index : indices )
+                bench_sink = msr_query( index, 0, backend ).msr_data;
+        }, indices.size() ) );
+
+        std::size_t decoded = 0;
+        for ( const auto& record : backend.records )
+            if ( record.status == msr_ok )
+                decoded += find_msr_schema( record.index ).size();
+
+        results.push_back( run_bench( ( "decode/" + tag ).c_str(), [ & ]
+        {
+            for ( const auto& record : backend.records )
+                if ( record.status == msr_ok )
+                    for ( const auto& schema : find_msr_schema( record.index ) | std::views::values )
+                        bench_sink = decode_register( record.value, schema.fields )[ 0 ];
+        }, decoded ) );
+
+        const msr_sweep_result sweep{ 0, backend.records };
+        results.push_back( run_bench( ( "report/msr/" + tag ).c_str(), [ & ] { print_msr_report( sweep, null_out ); }, sweep.records.size() ) );
+    }
+
+    fclose( null_out );
+
+    printf( "%-32s %14s %14s %12s\n", "benchmark", "iterations", "ns/op", "MB/s" );
+    for ( const auto& r : results )
+        printf( "%-32s %14llu %14.1f %12.1f\n", r.name.c_str(), static_cast< unsigned long long >( r.iterations ), r.ns_per_op, r.mb_per_s );
+
+    if ( json_path )
+        write_json( json_path, results );
+
+    return 0;
+}
@@ -23,6 +23,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
@@ -34,14 +37,8 @@ struct bitfield
     bitfield() : data( 0 ) {}
     bitfield( T data ) : data( data ) {}
 
-    bitfield( const bitfield& other ) : data( other.data ) {}
-
-    bitfield& operator=( const bitfield& other )
-    {
-        if ( this != &other )
-            data = other.data;
-        return *this;
-    }
+    bitfield( const bitfield& other ) = default;
+    bitfield& operator=( const bitfield& other ) = default;
 
     bool operator==( const bitfield& other ) const { return data == other.data; }
     bool operator!=( const bitfield& other ) const { return data != other.data; }
@@ -0,0 +1,224 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined( _WIN32 )
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined( __linux__ )
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Logical processors this process is allowed to run on, in ascending order. On Windows the
+// cpu number is the flat index across processor groups (group * 64 + bit).
+//
+inline std::vector<uint32_t> online_cpus()
+{
+    std::vector<uint32_t> cpus;
+
+#if defined( _WIN32 )
+    const WORD groups = GetActiveProcessorGroupCount();
+    for ( WORD g = 0; g < groups; ++g )
+    {
+        const DWORD count = GetActiveProcessorCount( g );
+        for ( DWORD i = 0; i < count; ++i )
+            cpus.push_back( g * 64u + i );
+    }
+#elif defined( __linux__ )
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    if ( sched_getaffinity( 0, sizeof( set ), &set ) == 0 )
+    {
+        for ( uint32_t i = 0; i < CPU_SETSIZE; ++i )
+            if ( CPU_ISSET( i, &set ) )
+                cpus.push_back( i );
+    }
+#endif
+
+    if ( cpus.empty() )
+        cpus.push_back( 0 );
+
+    return cpus;
+}
+
+inline bool pin_current_thread( uint32_t cpu )
+{
+#if defined( _WIN32 )
+    GROUP_AFFINITY affinity{};
+    affinity.Group = static_cast< WORD >( cpu / 64 );
+    affinity.Mask = KAFFINITY( 1 ) << ( cpu % 64 );
+    return SetThreadGroupAffinity( GetCurrentThread(), &affinity, nullptr ) != 0;
+#elif defined( __linux__ )
+    if ( cpu >= CPU_SETSIZE )
+        return false;
+
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    CPU_SET( cpu, &set );
+    return pthread_setaffinity_np( pthread_self(), sizeof( set ), &set ) == 0;
+#else
+    return false;
+#endif
+}
+
+// Set of logical processors, numbered as in online_cpus().
+//
+struct cpu_set
+{
+    cpu_set() = default;
+    cpu_set( std::initializer_list<uint32_t> cpus )
+    {
+        for ( const auto cpu : cpus )
+            insert( cpu );
+    }
+
+    void insert( uint32_t cpu )
+    {
+        if ( cpu / 64 >= words.size() )
+            words.resize( cpu / 64 + 1 );
+        words[ cpu / 64 ] |= uint64_t( 1 ) << ( cpu % 64 );
+    }
+
+    void insert( const cpu_set& other )
+    {
+        if ( other.words.size() > words.size() )
+            words.resize( other.words.size() );
+        for ( std::size_t i = 0; i < other.words.size(); ++i )
+            words[ i ] |= other.words[ i ];
+    }
+
+    [[nodiscard]] bool contains( uint32_t cpu ) const
+    {
+        return cpu / 64 < words.size() && ( words[ cpu / 64 ] >> ( cpu % 64 ) ) & 1;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        std::size_t count = 0;
+        for ( const auto word : words )
+            count += std::popcount( word );
+        return count;
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    [[nodiscard]] std::vector<uint32_t> to_vector() const
+    {
+        std::vector<uint32_t> cpus;
+        for ( std::size_t i = 0; i < words.size(); ++i )
+            for ( uint64_t word = words[ i ]; word; word &= word - 1 )
+                cpus.push_back( static_cast< uint32_t >( i * 64 + std::countr_zero( word ) ) );
+        return cpus;
+    }
+
+    friend bool operator==( const cpu_set&, const cpu_set& ) = default;
+
+    std::vector<uint64_t> words;    // bit n of word w is cpu w * 64 + n; no trailing zero words
+};
+
+// Lets the calling thread run on any cpu of the set. On Windows a thread can only be affine to one
+// processor group, so only the cpus in the group of the lowest cpu are used.
+//
+inline bool pin_current_thread( const cpu_set& cpus )
+{
+    const auto list = cpus.to_vector();
+    if ( list.empty() )
+        return false;
+
+#if defined( _WIN32 )
+    GROUP_AFFINITY affinity{};
+    affinity.Group = static_cast< WORD >( list.front() / 64 );
+    affinity.Mask = static_cast< KAFFINITY >( cpus.words[ list.front() / 64 ] );
+    return SetThreadGroupAffinity( GetCurrentThread(), &affinity, nullptr ) != 0;
+#elif defined( __linux__ )
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    for ( const auto cpu : list )
+        if ( cpu < CPU_SETSIZE )
+            CPU_SET( cpu, &set );
+    return pthread_setaffinity_np( pthread_self(), sizeof( set ), &set ) == 0;
+#else
+    return false;
+#endif
+}
+
+// Cpu the calling thread is running on, numbered as in online_cpus(). Unless the thread is pinned
+// it may already have moved by the time the caller looks at the result.
+//
+inline uint32_t current_cpu()
+{
+#if defined( _WIN32 )
+    PROCESSOR_NUMBER number;
+    GetCurrentProcessorNumberEx( &number );
+    return number.Group * 64u + number.Number;
+#elif defined( __linux__ )
+    const int cpu = sched_getcpu();
+    return cpu < 0 ? 0 : static_cast< uint32_t >( cpu );
+#else
+    return 0;
+#endif
+}
+
+// Runs fn( slot, cpu ) on one worker per cpu, each pinned to its cpu before fn is called,
+// and joins them all. slot is the position of cpu in the list so workers can write results
+// into preallocated storage without synchronizing.
+//
+// A worker that cannot be pinned (offline cpu, outside the process affinity) never calls fn,
+// since anything it read would describe whichever cpu it happened to run on. The returned
+// vector holds one entry per slot, false for those.
+//
+template <typename Fn>
+std::vector<bool> for_each_cpu_parallel( const std::vector<uint32_t>& cpus, Fn&& fn )
+{
+    std::vector<std::thread> workers;
+    workers.reserve( cpus.size() );
+
+    // Bytes rather than std::vector<bool>, whose packed bits workers could not write concurrently.
+    //
+    std::vector<uint8_t> pinned( cpus.size() );
+    for ( std::size_t slot = 0; slot < cpus.size(); ++slot )
+    {
+        workers.emplace_back( [ &fn, &pinned, slot, cpu = cpus[ slot ] ]
+        {
+            pinned[ slot ] = pin_current_thread( cpu );
+            if ( pinned[ slot ] )
+                fn( slot, cpu );
+        } );
+    }
+
+    for ( auto& worker : workers )
+        worker.join();
+
+    return { pinned.begin(), pinned.end() };
+}
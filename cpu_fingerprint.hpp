@@ -0,0 +1,215 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "cpu_affinity.hpp"
+#include "cpuid.hpp"
+#include "field_ref.hpp"
+#include "msr.hpp"
+#include "snapshot.hpp"
+
+// 128-bit fingerprint of a machine's CPUID leaves plus a few static MSRs. Fields that differ
+// between cores of the same machine are masked off, so every cpu of a host -- and every host of
+// the same SKU, microcode and firmware settings -- hashes the same.
+//
+struct cpu_fingerprint
+{
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    bool operator==( const cpu_fingerprint& ) const = default;
+};
+
+// For std::unordered_map/set keyed on fingerprints; the low half is already well mixed.
+//
+struct cpu_fingerprint_hash
+{
+    std::size_t operator()( const cpu_fingerprint& fp ) const noexcept { return static_cast< std::size_t >( fp.lo ); }
+};
+
+constexpr uint32_t fingerprint_any_subleaf = 0xffffffff;
+
+// Bits of one CPUID register cleared before hashing.
+//
+struct fingerprint_mask
+{
+    uint32_t leaf;
+    uint32_t subleaf;           // or fingerprint_any_subleaf
+    e_cpuid_registers reg;
+    uint32_t mask;
+};
+
+inline constexpr fingerprint_mask default_fingerprint_masks[] = {
+    { 0x01, 0, ebx, static_cast< uint32_t >( cpuid_field_ref<0x01, "ebx", "initial_apic_id">::field.mask ) },
+    { 0x0b, fingerprint_any_subleaf, ebx, 0x0000ffff },        // logical processors at level: 2 on a P-core, 1 on an E-core
+    { 0x0b, fingerprint_any_subleaf, edx, 0xffffffff },        // x2APIC id
+    { 0x1a, 0, eax, 0xffffffff },                              // core type on hybrid parts
+    { 0x1f, fingerprint_any_subleaf, ebx, 0x0000ffff },        // logical processors at level
+    { 0x1f, fingerprint_any_subleaf, edx, 0xffffffff },        // x2APIC id
+    { 0x8000001e, 0, eax, 0xffffffff },                        // extended APIC id
+    { 0x8000001e, 0, ebx, 0x000000ff },                        // compute unit id
+    { 0x8000001e, 0, ecx, 0x000000ff },                        // node id
+    { 0x80000026, fingerprint_any_subleaf, edx, 0xffffffff },  // x2APIC id
+};
+
+// Leaves left out entirely: on hybrid parts they describe the core type of the cpu they run on
+// (leaf 4 cache sizes and sharing, 0x0A and 0x23 performance counters, 0x18 TLBs, 0x80000006 L2),
+// including how many subleaves exist.
+//
+inline constexpr uint32_t default_fingerprint_skipped_leaves[] = { 0x04, 0x0a, 0x18, 0x23, 0x80000006 };
+
+inline constexpr uint32_t default_fingerprint_msrs[] = {
+    0x8b,       // ia32_bios_sign_id (microcode revision)
+    0xce,       // msr_platform_info
+    0x10a,      // ia32_arch_capabilities
+};
+
+struct fingerprint_options
+{
+    std::span<const fingerprint_mask> masks = default_fingerprint_masks;
+    std::span<const uint32_t> skipped_leaves = default_fingerprint_skipped_leaves;
+    std::span<const uint32_t> msrs = default_fingerprint_msrs;
+    uint32_t cpu = 0;           // cpu the CPUID leaves and MSRs are read from
+
+    [[nodiscard]] bool skips( uint32_t leaf ) const
+    {
+        for ( const auto skipped : skipped_leaves )
+            if ( skipped == leaf )
+                return true;
+        return false;
+    }
+};
+
+// Two independent 64-bit multiply/rotate lanes, cross-mixed on finish. Not cryptographic; it only
+// has to keep distinct configurations apart.
+//
+struct fingerprint_hasher
+{
+    uint64_t lo = 0x9e3779b97f4a7c15;
+    uint64_t hi = 0xc2b2ae3d27d4eb4f;
+    uint64_t words = 0;
+
+    void add( uint64_t v )
+    {
+        lo = std::rotl( lo ^ ( v * 0x87c37b91114253d5 ), 31 ) * 0x4cf5ad432745937f;
+        hi = std::rotl( hi ^ ( v * 0x4cf5ad432745937f ), 33 ) * 0x87c37b91114253d5;
+        ++words;
+    }
+
+    static uint64_t fmix( uint64_t k )
+    {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccd;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53;
+        k ^= k >> 33;
+        return k;
+    }
+
+    [[nodiscard]] cpu_fingerprint finish() const
+    {
+        uint64_t a = lo ^ words, b = hi ^ words;
+        a += b;
+        b += a;
+        a = fmix( a );
+        b = fmix( b );
+        a += b;
+        b += a;
+        return { a, b };
+    }
+
+    void add_cpuid( uint32_t leaf, uint32_t subleaf, const uint32_t regs[ 4 ], std::span<const fingerprint_mask> masks )
+    {
+        uint32_t masked[ 4 ] = { regs[ 0 ], regs[ 1 ], regs[ 2 ], regs[ 3 ] };
+        for ( const auto& m : masks )
+            if ( m.leaf == leaf && ( m.subleaf == fingerprint_any_subleaf || m.subleaf == subleaf ) )
+                masked[ m.reg ] &= ~m.mask;
+
+        add( ( uint64_t( leaf ) << 32 ) | subleaf );
+        add( ( uint64_t( masked[ 1 ] ) << 32 ) | masked[ 0 ] );
+        add( ( uint64_t( masked[ 3 ] ) << 32 ) | masked[ 2 ] );
+    }
+
+    void add_msr( uint32_t index, uint32_t status, uint64_t value )
+    {
+        add( ( uint64_t( status ) << 32 ) | index );
+        add( status == msr_ok ? value : 0 );
+    }
+};
+
+// Fingerprint of the running machine: every leaf for_each_cpuid_leaf issues, then options.msrs.
+// Both are read on a worker pinned to options.cpu, so the caller's affinity is untouched. A cpu
+// that cannot be pinned yields an all-zero fingerprint.
+//
+inline cpu_fingerprint fingerprint_cpu( const fingerprint_options& options = {}, cpuid_backend& cpuid_source = get_cpuid_backend(), msr_backend& msr_source = get_msr_backend() )
+{
+    fingerprint_hasher hasher;
+
+    const auto pinned = for_each_cpu_parallel( { options.cpu }, [ & ] ( std::size_t, uint32_t )
+    {
+        for_each_cpuid_leaf( [ & ] ( cpu_query& leaf )
+        {
+            const auto function_id = static_cast< uint32_t >( leaf.function_id() );
+            if ( options.skips( function_id ) )
+                return;
+
+            const auto* regs = reinterpret_cast< const uint32_t* >( leaf.registers() );
+            hasher.add_cpuid( function_id, static_cast< uint32_t >( leaf.subfunction_id() ), regs, options.masks );
+        }, cpuid_source );
+
+        for ( const auto index : options.msrs )
+        {
+            uint64_t value = 0;
+            const auto status = msr_source.read( options.cpu, index, value );
+            hasher.add_msr( index, status, value );
+        }
+    } );
+
+    return pinned.front() ? hasher.finish() : cpu_fingerprint{};
+}
+
+// Same fingerprint computed from one cpu of a stored snapshot; matches fingerprint_cpu for a
+// snapshot captured on that machine.
+//
+inline cpu_fingerprint fingerprint_snapshot( const snapshot_view& snapshot, const fingerprint_options& options = {} )
+{
+    fingerprint_hasher hasher;
+
+    if ( const auto* entry = snapshot.find_cpu( options.cpu ) )
+        for ( const auto& leaf : snapshot.cpuid_of( *entry ) )
+            if ( !options.skips( leaf.leaf ) )
+                hasher.add_cpuid( leaf.leaf, leaf.subleaf, leaf.regs, options.masks );
+
+    for ( const auto index : options.msrs )
+    {
+        const auto state = snapshot.find_msr( options.cpu, index );
+        hasher.add_msr( index, state.status, state.value );
+    }
+
+    return hasher.finish();
+}
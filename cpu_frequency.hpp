@@ -0,0 +1,247 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "cpu_affinity.hpp"
+#include "cpuid.hpp"
+#include "field_ref.hpp"
+#include "msr_watch.hpp"
+#include "tsc.hpp"
+
+enum e_tsc_source
+{
+    tsc_source_unknown = 0,
+    tsc_source_crystal = 1,         // leaf 15h crystal clock * ratio
+    tsc_source_base_frequency = 2,  // leaf 16h base frequency
+    tsc_source_calibrated = 3       // measured against the OS clock
+};
+
+struct tsc_frequency
+{
+    uint64_t hz = 0;
+    e_tsc_source source = tsc_source_unknown;
+};
+
+// Nominal TSC rate from CPUID, per the SDM: leaf 15h gives crystal * numerator / denominator. When
+// it reports the ratio but not the crystal, the TSC runs at the leaf 16h base frequency. Hypervisors
+// often hide both leaves, in which case this returns tsc_source_unknown.
+//
+inline tsc_frequency cpuid_tsc_frequency( cpuid_backend& backend = get_cpuid_backend() )
+{
+    using max_leaf = cpuid_field_ref<0x0, "eax", "max_input_value_cpuid">;
+    using denominator = cpuid_field_ref<0x15, "eax", "denominator_tsc_core_crystal_clock_ratio">;
+    using numerator = cpuid_field_ref<0x15, "ebx", "numerator_tsc_core_crystal_clock_ratio">;
+    using crystal = cpuid_field_ref<0x15, "ecx", "core_crystal_clock_freq">;
+    using base_mhz = cpuid_field_ref<0x16, "eax", "processor_base_frequency_mhz">;
+
+    const uint32_t max = max_leaf::get( cpu_query( 0x0, 0, backend ) );
+
+    if ( max >= 0x15 )
+    {
+        const cpu_query leaf_15( 0x15, 0, backend );
+        if ( denominator::get( leaf_15 ) && numerator::get( leaf_15 ) && crystal::get( leaf_15 ) )
+            return { uint64_t( crystal::get( leaf_15 ) ) * numerator::get( leaf_15 ) / denominator::get( leaf_15 ), tsc_source_crystal };
+    }
+
+    if ( max >= 0x16 )
+    {
+        const cpu_query leaf_16( 0x16, 0, backend );
+        if ( base_mhz::get( leaf_16 ) )
+            return { uint64_t( base_mhz::get( leaf_16 ) ) * 1000000, tsc_source_base_frequency };
+    }
+
+    return {};
+}
+
+// Counts TSC ticks across a sleep on the OS monotonic clock. Accurate to well under 0.1% at the
+// default 50 ms as long as the TSC is invariant.
+//
+inline tsc_frequency calibrate_tsc_frequency( std::chrono::nanoseconds duration = std::chrono::milliseconds( 50 ) )
+{
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t start_tsc = tsc_begin();
+
+    std::this_thread::sleep_for( duration );
+
+    const uint64_t end_tsc = tsc_end();
+    const auto elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    return { static_cast< uint64_t >( double( end_tsc - start_tsc ) / elapsed ), tsc_source_calibrated };
+}
+
+// Resolved once per process; the first call may sleep for the calibration.
+//
+inline tsc_frequency get_tsc_frequency()
+{
+    static const tsc_frequency frequency = []
+    {
+        const auto from_cpuid = cpuid_tsc_frequency();
+        return from_cpuid.hz ? from_cpuid : calibrate_tsc_frequency();
+    }();
+    return frequency;
+}
+
+// One interval between two APERF/MPERF reads on a cpu, with turbostat's meaning:
+//
+//   avg_mhz    = tsc_hz * dAPERF / dTSC     average clock over the whole interval, idle included
+//   busy_mhz   = tsc_hz * dAPERF / dMPERF   effective clock while in C0
+//   c0_percent = 100 * dMPERF / dTSC        C0 residency
+//
+struct frequency_point
+{
+    uint64_t tsc;           // end of the interval
+    double avg_mhz;
+    double busy_mhz;
+    double c0_percent;
+};
+
+struct frequency_series
+{
+    uint32_t cpu;
+    std::vector<frequency_point> points;
+};
+
+inline constexpr uint32_t ia32_mperf = 0xe7;
+inline constexpr uint32_t ia32_aperf = 0xe8;
+
+// Turns ia32_mperf / ia32_aperf samples into per-cpu frequency_series. Feed it from
+// msr_watch::drain with the watch set to { ia32_mperf, ia32_aperf }: MPERF is read first in each
+// round and its TSC stamp is taken as the time of the pair.
+//
+struct frequency_telemetry
+{
+    explicit frequency_telemetry( std::vector<uint32_t> cpus, tsc_frequency tsc = get_tsc_frequency() ) : tsc( tsc )
+    {
+        std::ranges::sort( cpus );
+        for ( const auto cpu : cpus )
+            series.push_back( { cpu, {} } );
+        state.resize( cpus.size() );
+    }
+
+    void add( uint32_t cpu, const msr_sample& sample )
+    {
+        const auto it = std::ranges::lower_bound( series, cpu, {}, &frequency_series::cpu );
+        if ( it == series.end() || it->cpu != cpu )
+            return;
+
+        auto& s = state[ it - series.begin() ];
+        if ( sample.status != msr_ok )
+        {
+            s.have_mperf = false;
+            return;
+        }
+
+        if ( sample.index == ia32_mperf )
+        {
+            s.mperf = sample.value;
+            s.mperf_tsc = sample.tsc;
+            s.have_mperf = true;
+            return;
+        }
+
+        if ( sample.index != ia32_aperf || !s.have_mperf )
+            return;
+
+        s.have_mperf = false;
+        if ( s.have_previous )
+        {
+            // Unsigned differences stay correct across a counter wrap.
+            //
+            const double d_tsc = double( s.mperf_tsc - s.previous_tsc );
+            const double d_mperf = double( s.mperf - s.previous_mperf );
+            const double d_aperf = double( sample.value - s.previous_aperf );
+            const double mhz = double( tsc.hz ) / 1e6;
+
+            if ( d_tsc > 0 )
+                it->points.push_back( { s.mperf_tsc,
+                                        mhz * d_aperf / d_tsc,
+                                        d_mperf > 0 ? mhz * d_aperf / d_mperf : 0.0,
+                                        std::min( 100.0, 100.0 * d_mperf / d_tsc ) } );
+        }
+
+        s.previous_tsc = s.mperf_tsc;
+        s.previous_mperf = s.mperf;
+        s.previous_aperf = sample.value;
+        s.have_previous = true;
+    }
+
+    tsc_frequency tsc;
+    std::vector<frequency_series> series;   // ascending by cpu
+
+    private:
+    struct cpu_state
+    {
+        uint64_t mperf_tsc = 0;
+        uint64_t mperf = 0;
+        bool have_mperf = false;
+
+        uint64_t previous_tsc = 0;
+        uint64_t previous_mperf = 0;
+        uint64_t previous_aperf = 0;
+        bool have_previous = false;
+    };
+
+    std::vector<cpu_state> state;
+};
+
+struct frequency_options
+{
+    std::vector<uint32_t> cpus = online_cpus();
+    std::chrono::nanoseconds interval = std::chrono::milliseconds( 100 );
+    std::chrono::nanoseconds duration = std::chrono::seconds( 1 );
+    tsc_frequency tsc = {};     // get_tsc_frequency() if hz is 0
+};
+
+// Samples APERF/MPERF on every cpu for options.duration and returns one series per cpu, with
+// roughly duration / interval points each. Cpus the backend cannot read come back with no points.
+//
+inline std::vector<frequency_series> collect_frequency( const frequency_options& options = {}, msr_backend& backend = get_msr_backend() )
+{
+    frequency_telemetry telemetry( options.cpus, options.tsc.hz ? options.tsc : get_tsc_frequency() );
+
+    msr_watch_options watch_options;
+    watch_options.msrs = { ia32_mperf, ia32_aperf };
+    watch_options.cpus = options.cpus;
+    watch_options.interval = options.interval;
+
+    msr_watch watch( watch_options, backend );
+    const auto add = [ & ] ( uint32_t cpu, const msr_sample& sample ) { telemetry.add( cpu, sample ); };
+
+    const auto deadline = std::chrono::steady_clock::now() + options.duration;
+    watch.start();
+    while ( watch.sampling() && std::chrono::steady_clock::now() < deadline )
+    {
+        watch.drain( add );
+        std::this_thread::sleep_for( std::min<std::chrono::nanoseconds>( options.interval, deadline - std::chrono::steady_clock::now() ) );
+    }
+
+    watch.stop();
+    watch.drain( add );
+    return std::move( telemetry.series );
+}
@@ -0,0 +1,330 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "cpu_affinity.hpp"
+#include "cpuid.hpp"
+#include "field_ref.hpp"
+
+// Levels of the x2APIC id hierarchy, innermost first. The values of thread..die are the leaf
+// 0x1F domain types minus one; leaf 0xB only reports thread and core.
+//
+enum e_topology_level
+{
+    topology_thread = 0,
+    topology_core = 1,
+    topology_module = 2,
+    topology_tile = 3,
+    topology_die = 4,
+    topology_package = 5,
+    topology_level_count = 6
+};
+
+inline const char* topology_level_name( e_topology_level level )
+{
+    switch ( level )
+    {
+        case topology_thread: return "thread";
+        case topology_core: return "core";
+        case topology_module: return "module";
+        case topology_tile: return "tile";
+        case topology_die: return "die";
+        case topology_package: return "package";
+        default: return "unknown";
+    }
+}
+
+enum e_cache_type
+{
+    cache_null = 0,
+    cache_data = 1,
+    cache_instruction = 2,
+    cache_unified = 3
+};
+
+// Where one logical processor sits. ids[ level ] is the x2APIC id with the bits below that level
+// shifted out, so it is unique across the machine at each level but not dense. A level the cpu
+// does not report (e.g. module without leaf 0x1F) gets the id of the level below it.
+//
+struct cpu_location
+{
+    uint32_t cpu;
+    uint32_t x2apic_id;
+    std::array<uint32_t, topology_level_count> ids;
+};
+
+struct topology_node
+{
+    e_topology_level level;
+    uint32_t id;
+    cpu_set cpus;
+    std::vector<topology_node> children;    // next present level down, ascending by id
+};
+
+// One cache instance from leaf 4 and the cpus sharing it.
+//
+struct cache_group
+{
+    uint32_t level;
+    e_cache_type type;
+    uint32_t id;            // x2APIC id with the sharing bits cleared, i.e. the lowest id that can share it
+    uint64_t size;          // bytes
+    uint32_t line_size;
+    uint32_t ways;
+    cpu_set cpus;
+};
+
+struct cpu_topology
+{
+    std::vector<cpu_location> cpus;                     // ascending by cpu
+    std::vector<topology_node> packages;                // roots of the tree
+    std::vector<cache_group> caches;                    // ascending by level, type, id
+    std::array<bool, topology_level_count> present{};   // levels reported by at least one cpu
+
+    [[nodiscard]] const cpu_location* find_cpu( uint32_t cpu ) const
+    {
+        const auto it = std::ranges::lower_bound( cpus, cpu, {}, &cpu_location::cpu );
+        return ( it != cpus.end() && it->cpu == cpu ) ? &*it : nullptr;
+    }
+
+    // Every instance of a level as a cpu set, e.g. one set per physical core.
+    //
+    [[nodiscard]] std::vector<cpu_set> sets_at( e_topology_level level ) const
+    {
+        std::map<uint32_t, cpu_set> sets;
+        for ( const auto& location : cpus )
+            sets[ location.ids[ level ] ].insert( location.cpu );
+
+        std::vector<cpu_set> result;
+        for ( auto& [id, set] : sets )
+            result.push_back( std::move( set ) );
+        return result;
+    }
+
+    // The data/unified cache of the given level that cpu uses, or nullptr.
+    //
+    [[nodiscard]] const cache_group* cache_of( uint32_t cpu, uint32_t level ) const
+    {
+        for ( const auto& cache : caches )
+            if ( cache.level == level && cache.type != cache_instruction && cache.cpus.contains( cpu ) )
+                return &cache;
+        return nullptr;
+    }
+};
+
+struct topology_domain
+{
+    uint32_t type;      // leaf 0xB/0x1F domain type, 0 terminates
+    uint32_t shift;     // x2APIC id bits below the next domain up
+};
+
+struct topology_cache
+{
+    uint32_t level;
+    uint32_t type;
+    uint32_t shift;     // x2APIC id bits that differ between cpus sharing the cache
+    uint64_t size;
+    uint32_t line_size;
+    uint32_t ways;
+};
+
+// Per-cpu CPUID results, gathered on each cpu before the machine-wide model is assembled.
+//
+struct raw_cpu_topology
+{
+    uint32_t x2apic_id = 0;
+    std::vector<topology_domain> domains;
+    std::vector<topology_cache> caches;
+};
+
+// Must run on the cpu being described.
+//
+inline raw_cpu_topology read_cpu_topology( cpuid_backend& backend )
+{
+    using max_leaf = cpuid_field_ref<0x0, "eax", "max_input_value_cpuid">;
+    using initial_apic_id = cpuid_field_ref<0x1, "ebx", "initial_apic_id">;
+    using domain_shift = cpuid_field_ref<0xb, "eax", "x2apic_shift">;
+    using domain_processors = cpuid_field_ref<0xb, "ebx", "logical_processors">;
+    using domain_type = cpuid_field_ref<0xb, "ecx", "domain_type">;
+    using x2apic_id = cpuid_field_ref<0xb, "edx", "x2apic_id_current_lp">;
+    using cache_type = cpuid_field_ref<0x4, "eax", "cache_type">;
+    using cache_level = cpuid_field_ref<0x4, "eax", "cache_level">;
+    using cache_sharing = cpuid_field_ref<0x4, "eax", "logical_processors">;
+    using line_size = cpuid_field_ref<0x4, "ebx", "line_size">;
+    using partitions = cpuid_field_ref<0x4, "ebx", "partitions">;
+    using ways = cpuid_field_ref<0x4, "ebx", "ways_of_associativity">;
+    using sets = cpuid_field_ref<0x4, "ecx", "number_of_sets">;
+
+    raw_cpu_topology raw;
+    const uint32_t max = max_leaf::get( cpu_query( 0x0, 0, backend ) );
+    raw.x2apic_id = initial_apic_id::get( cpu_query( 0x1, 0, backend ) );
+
+    // Leaf 0x1F supersedes 0xB when present; both share the register layout.
+    //
+    for ( const int32_t leaf : { 0x1f, 0xb } )
+    {
+        if ( static_cast< uint32_t >( leaf ) > max || !domain_processors::get( cpu_query( leaf, 0, backend ) ) )
+            continue;
+
+        for_each_cpuid_subleaf( leaf, [ & ] ( cpu_query& query )
+        {
+            if ( !domain_type::get( query ) )
+                return;
+
+            raw.x2apic_id = x2apic_id::get( query );
+            raw.domains.push_back( { domain_type::get( query ), domain_shift::get( query ) } );
+        }, backend );
+        break;
+    }
+
+    if ( max >= 0x4 )
+    {
+        for_each_cpuid_subleaf( 0x4, [ & ] ( cpu_query& query )
+        {
+            if ( !cache_type::get( query ) )
+                return;
+
+            const uint32_t sharing = cache_sharing::get( query ) + 1;
+            raw.caches.push_back( { cache_level::get( query ), cache_type::get( query ),
+                                    static_cast< uint32_t >( std::bit_width( sharing - 1 ) ),
+                                    uint64_t( ways::get( query ) + 1 ) * ( partitions::get( query ) + 1 ) *
+                                    ( line_size::get( query ) + 1 ) * ( uint64_t( sets::get( query ) ) + 1 ),
+                                    line_size::get( query ) + 1, ways::get( query ) + 1 } );
+        }, backend );
+    }
+
+    return raw;
+}
+
+inline std::array<uint32_t, topology_level_count> topology_level_ids( const raw_cpu_topology& raw, std::array<bool, topology_level_count>& present )
+{
+    // Each domain's shift gives the id of the next domain up; the last one gives the package.
+    //
+    std::array<uint32_t, topology_level_count> ids{};
+    std::array<bool, topology_level_count> known{};
+    ids[ topology_thread ] = raw.x2apic_id;
+    known[ topology_thread ] = true;
+
+    for ( std::size_t i = 0; i < raw.domains.size(); ++i )
+    {
+        const uint32_t up = i + 1 < raw.domains.size() ? raw.domains[ i + 1 ].type - 1 : uint32_t( topology_package );
+        if ( up <= topology_thread || up > topology_package )
+            continue;
+
+        const uint32_t shift = raw.domains[ i ].shift;
+        ids[ up ] = shift < 32 ? raw.x2apic_id >> shift : 0;
+        known[ up ] = true;
+    }
+
+    // Without leaf 0xB/0x1F all that is known is the package; treat the initial APIC id as
+    // one thread per package.
+    //
+    known[ topology_package ] = true;
+    if ( raw.domains.empty() )
+        ids[ topology_package ] = raw.x2apic_id;
+
+    for ( std::size_t level = topology_core; level < topology_level_count; ++level )
+    {
+        if ( known[ level ] )
+            present[ level ] = true;
+        else
+            ids[ level ] = ids[ level - 1 ];
+    }
+
+    present[ topology_thread ] = true;
+    return ids;
+}
+
+inline void build_topology_level( std::vector<topology_node>& nodes, const std::vector<cpu_location>& cpus,
+                                  const std::array<bool, topology_level_count>& present, int level )
+{
+    std::map<uint32_t, std::vector<cpu_location>> groups;
+    for ( const auto& location : cpus )
+        groups[ location.ids[ level ] ].push_back( location );
+
+    int below = level - 1;
+    while ( below >= 0 && !present[ below ] )
+        --below;
+
+    for ( const auto& [id, members] : groups )
+    {
+        topology_node node{ static_cast< e_topology_level >( level ), id, {}, {} };
+        for ( const auto& location : members )
+            node.cpus.insert( location.cpu );
+
+        if ( below >= 0 )
+            build_topology_level( node.children, members, present, below );
+
+        nodes.push_back( std::move( node ) );
+    }
+}
+
+// Runs leaves 0x1F (or 0xB) and 4 pinned to each cpu and assembles the package -> ... -> thread
+// tree and the cache sharing groups. The default backend is the raw CPUID instruction rather than
+// get_cpuid_backend(), so leaf 4 is read from each cpu rather than from an installed cpuid_cache.
+// Cpus that cannot be pinned are left out of the model.
+//
+inline cpu_topology build_cpu_topology( const std::vector<uint32_t>& cpus = online_cpus(), cpuid_backend& backend = native_cpuid_source )
+{
+    std::vector<raw_cpu_topology> raw( cpus.size() );
+    const auto pinned = for_each_cpu_parallel( cpus, [ & ] ( std::size_t slot, uint32_t )
+    {
+        raw[ slot ] = read_cpu_topology( backend );
+    } );
+
+    cpu_topology topology;
+    std::map<std::tuple<uint32_t, uint32_t, uint32_t>, cache_group> caches;
+
+    for ( std::size_t slot = 0; slot < cpus.size(); ++slot )
+    {
+        if ( !pinned[ slot ] )
+            continue;
+
+        const auto& entry = raw[ slot ];
+        topology.cpus.push_back( { cpus[ slot ], entry.x2apic_id, topology_level_ids( entry, topology.present ) } );
+
+        for ( const auto& cache : entry.caches )
+        {
+            const uint32_t id = cache.shift < 32 ? entry.x2apic_id & ~( ( uint32_t( 1 ) << cache.shift ) - 1 ) : 0;
+            auto [it, inserted] = caches.try_emplace( std::make_tuple( cache.level, cache.type, id ) );
+            if ( inserted )
+                it->second = { cache.level, static_cast< e_cache_type >( cache.type ), id, cache.size, cache.line_size, cache.ways, {} };
+            it->second.cpus.insert( cpus[ slot ] );
+        }
+    }
+
+    std::ranges::sort( topology.cpus, {}, &cpu_location::cpu );
+    for ( auto& [key, cache] : caches )
+        topology.caches.push_back( std::move( cache ) );
+
+    build_topology_level( topology.packages, topology.cpus, topology.present, topology_package );
+    return topology;
+}
@@ -22,11 +22,15 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <array>
-#include <intrin.h>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "bitfield.hpp"
+#include "cpuid_backend.hpp"
 #include "cpuid_schema.hpp"
 
 constexpr int32_t   initial_cpuid_function_id = 0x0000;
@@ -42,6 +46,34 @@ enum e_cpuid_registers
     edx = 3
 };
 
+inline constexpr function_schema cpuid_schema_empty{};
+
+// Schema for a leaf/subleaf, or an empty schema if the leaf is unknown. Subleaf-specific entries
+// are keyed (subleaf << 16) | leaf; 0xffff0000 | leaf is the fallback for any other subleaf.
+//
+constexpr const function_schema& find_cpuid_schema( int32_t function_id, int32_t subfunction_id = 0 )
+{
+    const auto lookup = [] ( uint32_t key ) -> const function_schema*
+    {
+        const auto search = cpuid_schema.find( key );
+        return search != cpuid_schema.end() ? &search->second : nullptr;
+    };
+
+    const auto leaf = static_cast< uint32_t >( function_id );
+
+    if ( subfunction_id > 0 && function_id < 0x40000000 )
+    {
+        if ( const auto* schema = lookup( ( static_cast< uint32_t >( subfunction_id ) << 16 ) | leaf ) )
+            return *schema;
+        if ( const auto* schema = lookup( 0xffff0000 | leaf ) )
+            return *schema;
+    }
+    else if ( const auto* schema = lookup( leaf ) )
+        return *schema;
+
+    return cpuid_schema_empty;
+}
+
 struct cpu_query
 {
 private:
@@ -49,41 +81,19 @@ private:
     int32_t _subfunction_id;
     int32_t info[ 4 ]{};
     std::array<bitfield<int32_t>, 4> bf;
-    function_schema schema;
+    const function_schema* schema;
 
 public:
-    cpu_query( int32_t function_id, int32_t subfunction_id = 0 ) : _function_id( function_id ), _subfunction_id( subfunction_id )
+    cpu_query( int32_t function_id, int32_t subfunction_id = 0, cpuid_backend& backend = get_cpuid_backend() )
+        : _function_id( function_id ), _subfunction_id( subfunction_id ), schema( &find_cpuid_schema( function_id, subfunction_id ) )
     {
-        __cpuidex( info, function_id, subfunction_id );
+        backend.query( info, function_id, subfunction_id );
 
         for ( int i = 0; i < 4; ++i )
             bf[ i ] = bitfield( info[ i ] );
-
-        int32_t composite_key = 0xffff0000;
-        composite_key |= function_id;
-
-        if ( subfunction_id > 0 && function_id < 0x40000000 )
-        {
-            // Iterate through the map to find the first schema that matches
-            for ( const auto& [mask, schema_func] : cpuid_schema )
-            {
-                if ( ( subfunction_id == ( mask >> 16 ) ) &&
-                     ( function_id == ( mask & 0x0000FFFF ) ) )
-                {
-                    schema = schema_func;
-                    break;
-                }
-
-                schema = cpuid_schema[ composite_key ];
-            }
-        }
-        else
-        {
-            schema = cpuid_schema[ function_id ];
-        }
     }
 
-    static std::size_t to_index( const std::string& name )
+    static constexpr std::size_t to_index( std::string_view name )
     {
         if ( name == "eax" ) return eax;
         if ( name == "ebx" ) return ebx;
@@ -110,37 +120,28 @@ public:
         uint32_t value;
     };
 
-    [[nodiscard]] int32_t get_by_name( const std::string& reg_name ) const
+    [[nodiscard]] int32_t get_by_name( std::string_view reg_name ) const
     {
         return info[ to_index( reg_name ) ];
     }
 
-    field_value get_by_name_index( const std::pair<std::string, std::size_t>& p )
+    field_value get_by_name_index( const std::pair<std::string_view, std::size_t>& p )
     {
-        const register_schema& reg_schema = schema[ p.first ];
+        const register_schema& reg_schema = ( *schema )[ p.first ];
         const cpuid_field& field = reg_schema.fields[ p.second ];
-        const int32_t reg_value = info[ to_index( p.first ) ];
-        if ( field.bit_start == field.bit_end )
-        {
-            return { field.name, uint32_t( reg_value >> field.bit_start ) & 1 };
-        }
-        uint32_t mask = ( ( 1U << ( field.bit_end - field.bit_start + 1 ) ) - 1 ) << field.bit_start;
-        return { field.name, ( reg_value & mask ) >> field.bit_start };
+        const uint32_t reg_value = static_cast< uint32_t >( info[ to_index( p.first ) ] );
+        return { std::string( field.name ), static_cast< uint32_t >( ( reg_value & field.mask ) >> ( field.bit_start & 63 ) ) };
     }
 
-    auto& get_bitfield( const std::string& reg_name ) { return bf[ to_index( reg_name ) ]; }
-    auto& operator[]( const std::string& reg_name ) { return bf[ to_index( reg_name ) ]; }
+    auto& get_bitfield( std::string_view reg_name ) { return bf[ to_index( reg_name ) ]; }
+    auto& operator[]( std::string_view reg_name ) { return bf[ to_index( reg_name ) ]; }
 
-    uint32_t get_bit( const std::string& reg_name, std::size_t bit_position ) { return bf[ to_index( reg_name ) ][ bit_position ]; }
+    uint32_t get_bit( std::string_view reg_name, std::size_t bit_position ) { return bf[ to_index( reg_name ) ][ bit_position ]; }
 
-    uint32_t get_bit_range( const std::string& reg_name, std::size_t bit_start, std::size_t bit_end )
+    uint32_t get_bit_range( std::string_view reg_name, std::size_t bit_start, std::size_t bit_end )
     {
-        uint32_t result = 0;
-        for ( std::size_t i = bit_start; i <= bit_end; ++i )
-        {
-            result |= ( get_bit( reg_name, i ) << ( i - bit_start ) );
-        }
-        return result;
+        const uint32_t reg_value = static_cast< uint32_t >( info[ to_index( reg_name ) ] );
+        return static_cast< uint32_t >( ( reg_value & field_mask( bit_start, bit_end ) ) >> ( bit_start & 63 ) );
     }
 
     auto find_field_iter( const register_schema& reg_schema, auto predicate )
@@ -153,9 +154,9 @@ public:
         return field_iter;
     }
 
-    bitfield<int32_t>::proxy_range get_field( const std::string& reg_name, const char* field_name )
+    bitfield<int32_t>::proxy_range get_field( std::string_view reg_name, const char* field_name )
     {
-        const register_schema& reg_schema = schema[ reg_name ];
+        const register_schema& reg_schema = ( *schema )[ reg_name ];
         const auto field_iter = find_field_iter( reg_schema, [ &field_name ] ( const cpuid_field& field )
         {
             return field.name == field_name;
@@ -164,29 +165,187 @@ public:
         return bf[ to_index( reg_name ) ].get_range( field_iter->bit_start, field_iter->bit_end );
     }
 
-    field_value get_field( const std::string& reg_name, std::pair<std::size_t, std::size_t> bit_range )
+    field_value get_field( std::string_view reg_name, std::pair<std::size_t, std::size_t> bit_range )
     {
-        const register_schema& reg_schema = schema[ reg_name ];
+        const register_schema& reg_schema = ( *schema )[ reg_name ];
         const auto field_iter = find_field_iter( reg_schema, [ &bit_range ] ( const cpuid_field& field )
         {
             return field.bit_start == bit_range.first && field.bit_end == bit_range.second;
         } );
 
         const uint32_t value = get_bit_range( reg_name, bit_range.first, bit_range.second );
-        return { field_iter->name, value };
+        return { std::string( field_iter->name ), value };
     }
 
-    field_value get_field( const std::string& reg_name, std::size_t bit_pos )
+    field_value get_field( std::string_view reg_name, std::size_t bit_pos )
     {
-        const register_schema& reg_schema = schema[ reg_name ];
+        const register_schema& reg_schema = ( *schema )[ reg_name ];
         const auto field_iter = find_field_iter( reg_schema, [ &bit_pos ] ( const cpuid_field& field )
         {
             return field.bit_start == bit_pos && field.bit_end == bit_pos;
         } );
 
         const uint32_t value = get_bit( reg_name, bit_pos );
-        return { field_iter->name, value };
+        return { std::string( field_iter->name ), value };
     }
 
-    [[nodiscard]] function_schema get_schema() const { return schema; }
-};
\ No newline at end of file
+    [[nodiscard]] const function_schema& get_schema() const { return *schema; }
+
+    [[nodiscard]] int32_t function_id() const { return _function_id; }
+    [[nodiscard]] int32_t subfunction_id() const { return _subfunction_id; }
+    [[nodiscard]] const int32_t* registers() const { return info; }
+};
+
+// Queries only point into the static schema tables, so they can be stored and copied in bulk.
+//
+static_assert( std::is_trivially_copyable_v<cpu_query> );
+
+// How the valid subleaves of a leaf are discovered, following the architectural rules. Subleaf 0
+// is always issued; the rule says which further subleaves exist.
+//
+enum e_subleaf_rule
+{
+    subleaf_max_in_eax,     // subleaf 0 eax is the highest valid subleaf
+    subleaf_until_zero,     // valid until the first subleaf whose type field (reg & mask) is 0
+    subleaf_bitmap,         // bit n of subleaf 0's reg & mask means subleaf n is valid
+    subleaf_xsave,          // 0xD: subleaf 1, then one per component supported in XCR0 | IA32_XSS
+    subleaf_sgx,            // 0x12: if subleaf 0 eax reports SGX1/SGX2, subleaf 1, then EPC sections from 2 until the type field is 0
+};
+
+struct subleaf_rule
+{
+    int32_t leaf;
+    e_subleaf_rule rule;
+    e_cpuid_registers reg;
+    uint32_t mask;
+};
+
+inline constexpr subleaf_rule cpuid_subleaf_rules[] = {
+    { 0x04, subleaf_until_zero, eax, 0x1f },        // cache type
+    { 0x07, subleaf_max_in_eax, eax, 0 },
+    { 0x0b, subleaf_until_zero, ecx, 0xff00 },      // level type
+    { 0x0d, subleaf_xsave, eax, 0 },
+    { 0x0f, subleaf_bitmap, edx, 0xfffffffe },      // monitoring resource types
+    { 0x10, subleaf_bitmap, ebx, 0xfffffffe },      // allocation resource types
+    { 0x12, subleaf_sgx, eax, 0xf },                // EPC section type
+    { 0x14, subleaf_max_in_eax, eax, 0 },
+    { 0x17, subleaf_max_in_eax, eax, 0 },
+    { 0x18, subleaf_max_in_eax, eax, 0 },
+    { 0x1b, subleaf_until_zero, eax, 0xfff },       // PCONFIG subleaf type
+    { 0x1d, subleaf_max_in_eax, eax, 0 },
+    { 0x1f, subleaf_until_zero, ecx, 0xff00 },      // level type
+    { 0x20, subleaf_max_in_eax, eax, 0 },
+    { 0x23, subleaf_bitmap, eax, 0xfffffffe },      // valid architectural perfmon subleaves
+    { 0x24, subleaf_max_in_eax, eax, 0 },
+};
+
+// Upper bound on subleaves per leaf, in case a hypervisor reports nonsense.
+//
+constexpr int32_t max_cpuid_subleaf = 63;
+
+constexpr const subleaf_rule* find_subleaf_rule( int32_t leaf )
+{
+    for ( const auto& rule : cpuid_subleaf_rules )
+        if ( rule.leaf == leaf )
+            return &rule;
+    return nullptr;
+}
+
+// Issues every valid subleaf of leaf in ascending order and hands each query to fn. Only the
+// instructions the termination rule needs are executed: one per valid subleaf, plus the final
+// zero-type subleaf for the subleaf_until_zero leaves.
+//
+template <typename Fn>
+void for_each_cpuid_subleaf( int32_t leaf, Fn&& fn, cpuid_backend& backend = get_cpuid_backend() )
+{
+    cpu_query first( leaf, 0, backend );
+    uint32_t regs[ 4 ];
+    for ( int i = 0; i < 4; ++i )
+        regs[ i ] = static_cast< uint32_t >( first.registers()[ i ] );
+    fn( first );
+
+    const subleaf_rule* rule = find_subleaf_rule( leaf );
+    if ( !rule )
+        return;
+
+    const auto issue = [ & ] ( int32_t sub )
+    {
+        cpu_query query( leaf, sub, backend );
+        fn( query );
+    };
+
+    const auto issue_bitmap = [ & ] ( uint64_t bitmap, int32_t from )
+    {
+        for ( int32_t sub = from; sub <= max_cpuid_subleaf; ++sub )
+            if ( ( bitmap >> sub ) & 1 )
+                issue( sub );
+    };
+
+    const auto issue_until_zero = [ & ] ( int32_t from )
+    {
+        for ( int32_t sub = from; sub <= max_cpuid_subleaf; ++sub )
+        {
+            cpu_query query( leaf, sub, backend );
+            if ( !( static_cast< uint32_t >( query.registers()[ rule->reg ] ) & rule->mask ) )
+                break;
+            fn( query );
+        }
+    };
+
+    switch ( rule->rule )
+    {
+        case subleaf_max_in_eax:
+            for ( int32_t sub = 1; sub <= static_cast< int32_t >( std::min<uint32_t>( regs[ eax ], max_cpuid_subleaf ) ); ++sub )
+                issue( sub );
+            break;
+
+        case subleaf_until_zero:
+            if ( regs[ rule->reg ] & rule->mask )
+                issue_until_zero( 1 );
+            break;
+
+        case subleaf_bitmap:
+            issue_bitmap( regs[ rule->reg ] & rule->mask, 1 );
+            break;
+
+        case subleaf_xsave:
+        {
+            cpu_query sub_1( leaf, 1, backend );
+            const uint64_t xcr0 = ( uint64_t( static_cast< uint32_t >( regs[ edx ] ) ) << 32 ) | regs[ eax ];
+            const uint64_t xss = ( uint64_t( static_cast< uint32_t >( sub_1.registers()[ edx ] ) ) << 32 ) | static_cast< uint32_t >( sub_1.registers()[ ecx ] );
+            fn( sub_1 );
+            issue_bitmap( xcr0 | xss, 2 );
+            break;
+        }
+
+        case subleaf_sgx:
+            // Without SGX1/SGX2 (subleaf 0 eax[1:0]) the attribute and EPC subleaves are empty.
+            //
+            if ( regs[ eax ] & 0x3 )
+            {
+                issue( 1 );
+                issue_until_zero( 2 );
+            }
+            break;
+    }
+}
+
+// Issues every leaf/subleaf the processor reports, in order, and hands each query to fn. Leaves
+// with subleaves are expanded by the rules in cpuid_subleaf_rules.
+//
+template <typename Fn>
+void for_each_cpuid_leaf( Fn&& fn, cpuid_backend& backend = get_cpuid_backend() )
+{
+    cpu_query tmp( initial_cpuid_function_id, 0, backend );
+    const int32_t max_cpuid_leaf = tmp.get_bit_range( "eax", 0, 31 );
+    fn( tmp );
+
+    for ( auto it = initial_cpuid_function_id + 1; it <= max_cpuid_leaf; it++ )
+        for_each_cpuid_subleaf( it, fn, backend );
+
+    for ( auto it = ext_cpuid_function_id; it < ext_cpuid_function_id_max; it++ )
+    {
+        cpu_query leaf( static_cast< int32_t >( it ), 0, backend );
+        fn( leaf );
+    }
+}
@@ -0,0 +1,78 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+// Instruction source behind cpu_query. The native backend executes CPUID on the calling
+// thread; replay, caching or emulating backends can be installed process-wide with
+// set_cpuid_backend(), or handed to a single cpu_query.
+//
+struct cpuid_backend
+{
+    virtual ~cpuid_backend() = default;
+    virtual void query( int32_t info[ 4 ], int32_t function_id, int32_t subfunction_id ) = 0;
+};
+
+inline void native_cpuid( int32_t info[ 4 ], int32_t function_id, int32_t subfunction_id )
+{
+#if defined( _MSC_VER )
+    __cpuidex( info, function_id, subfunction_id );
+#elif ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+    uint32_t a, b, c, d;
+    __asm__ __volatile__( "cpuid"
+                          : "=a"( a ), "=b"( b ), "=c"( c ), "=d"( d )
+                          : "a"( function_id ), "c"( subfunction_id ) );
+
+    info[ 0 ] = static_cast< int32_t >( a );
+    info[ 1 ] = static_cast< int32_t >( b );
+    info[ 2 ] = static_cast< int32_t >( c );
+    info[ 3 ] = static_cast< int32_t >( d );
+#else
+#error "cpuid_backend: no native CPUID implementation for this compiler/architecture"
+#endif
+}
+
+struct native_cpuid_backend final : cpuid_backend
+{
+    void query( int32_t info[ 4 ], int32_t function_id, int32_t subfunction_id ) override
+    {
+        native_cpuid( info, function_id, subfunction_id );
+    }
+};
+
+inline native_cpuid_backend native_cpuid_source;
+inline cpuid_backend* active_cpuid_backend = &native_cpuid_source;
+
+// Not synchronized; install alternate backends before any queries are issued.
+//
+inline void set_cpuid_backend( cpuid_backend* backend )
+{
+    active_cpuid_backend = backend ? backend : &native_cpuid_source;
+}
+
+inline cpuid_backend& get_cpuid_backend() { return *active_cpuid_backend; }
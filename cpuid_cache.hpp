@@ -0,0 +1,344 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "cpu_affinity.hpp"
+#include "cpuid_backend.hpp"
+
+// Process-wide CPUID result cache. Each (leaf, subleaf, cpu class) is executed once, on first use,
+// and every later query is served from memory with plain loads, so feature checks stop paying
+// a VM exit each time under a hypervisor.
+//
+// The cpu class separates core types on hybrid parts (leaf 0x1A), where leaves such as 4 and
+// 0x18 differ between P- and E-cores. On other machines every cpu is class 0 and no extra CPUID
+// is ever issued to classify one.
+//
+// Leaves whose registers differ per logical cpu (APIC ids in leaf 1 ebx, edx of every subleaf of
+// 0xB and 0x1F, AMD's extended APIC and compute unit ids in 0x8000001E and x2APIC id in
+// 0x80000026) are keyed by the calling cpu instead of its class, so each cpu executes them once
+// and is served its own ids afterwards.
+//
+// Entries are seqlock-protected slots in a fixed open-addressed table. Neither readers nor
+// writers ever wait: a reader that races with a fill or refresh queries the upstream backend
+// instead, and a writer that races with another one leaves the slot to it.
+//
+struct cpuid_cache final : cpuid_backend
+{
+    static constexpr std::size_t slot_bits = 12;
+    static constexpr std::size_t slot_count = std::size_t( 1 ) << slot_bits;
+    static constexpr std::size_t max_probe = 16;
+    static constexpr std::size_t max_cpus = 1024;
+
+    static constexpr uint32_t per_cpu_leaves[] = { 0x01, 0x0b, 0x1f, 0x8000001e, 0x80000026 };
+
+    // Leaves with changing fields: thermal and power state (6). The cache keeps serving the first
+    // value it saw until refresh_volatile() is called.
+    //
+    static constexpr int32_t volatile_leaves[] = { 0x06 };
+
+    explicit cpuid_cache( cpuid_backend& upstream = native_cpuid_source ) : upstream( upstream ) {}
+
+    void query( int32_t info[ 4 ], int32_t function_id, int32_t subfunction_id ) override
+    {
+        const auto [key, cpu] = key_for( function_id, subfunction_id );
+        if ( !key )
+            return upstream.query( info, function_id, subfunction_id );
+
+        const std::size_t home = hash( key );
+        for ( std::size_t probe = 0; probe < max_probe; ++probe )
+        {
+            auto& slot = slots[ ( home + probe ) % slot_count ];
+            uint64_t owner = slot.key.load( std::memory_order_acquire );
+
+            // A failed exchange reloads owner, so a slot claimed by another thread is checked below.
+            //
+            if ( owner == 0 && slot.key.compare_exchange_strong( owner, key, std::memory_order_acq_rel ) )
+            {
+                fill( slot, info, function_id, subfunction_id, cpu );
+                return;
+            }
+
+            if ( owner != key )
+                continue;
+
+            if ( read( slot, info ) )
+                return;
+
+            // Claimed but never filled: the first fill saw the thread migrate and backed out.
+            //
+            if ( slot.seq.load( std::memory_order_acquire ) == 0 )
+            {
+                fill( slot, info, function_id, subfunction_id, cpu );
+                return;
+            }
+
+            break;
+        }
+
+        // Slot still being filled or refreshed, or the table is full around this key.
+        //
+        upstream.query( info, function_id, subfunction_id );
+    }
+
+    // Re-executes a cached leaf on the calling cpu and replaces the stored value for its class, or
+    // for the cpu itself for per-cpu leaves. Returns false if nothing was replaced: the leaf is not
+    // cached there, the thread migrated while the leaf was executed, or another fill or refresh
+    // held the slot at the time.
+    //
+    bool refresh( int32_t function_id, int32_t subfunction_id = 0 )
+    {
+        const auto [key, cpu] = key_for( function_id, subfunction_id );
+        if ( !key )
+            return false;
+
+        const std::size_t home = hash( key );
+        for ( std::size_t probe = 0; probe < max_probe; ++probe )
+        {
+            auto& slot = slots[ ( home + probe ) % slot_count ];
+            if ( slot.key.load( std::memory_order_acquire ) != key )
+                continue;
+
+            int32_t info[ 4 ];
+            return fill( slot, info, function_id, subfunction_id, cpu );
+        }
+
+        return false;
+    }
+
+    // Every cached subleaf of the volatile leaves, for the calling cpu's class. Returns false if
+    // any of them was not replaced.
+    //
+    bool refresh_volatile()
+    {
+        const auto cls = cpu_class();
+        if ( !cls.usable )
+            return false;
+
+        bool refreshed = true;
+
+        for ( auto& slot : slots )
+        {
+            const uint64_t key = slot.key.load( std::memory_order_acquire );
+            if ( !key || ( key >> 56 ) != cls.value )
+                continue;
+
+            const auto leaf = static_cast< int32_t >( static_cast< uint32_t >( key ) );
+            if ( std::ranges::find( volatile_leaves, leaf ) == std::end( volatile_leaves ) )
+                continue;
+
+            int32_t info[ 4 ];
+            refreshed &= fill( slot, info, leaf, static_cast< int32_t >( ( key >> 32 ) & 0x7fffff ), cls.cpu );
+        }
+
+        return refreshed;
+    }
+
+    private:
+    struct slot_entry
+    {
+        std::atomic<uint64_t> key{ 0 };
+        std::atomic<uint32_t> seq{ 0 };                 // 0 empty, odd while writing
+        std::array<std::atomic<int32_t>, 4> regs{};
+    };
+
+    cpuid_backend& upstream;
+    std::array<slot_entry, slot_count> slots;
+    std::array<std::atomic<uint8_t>, max_cpus> cpu_classes{};   // class + 1, 0 = not classified yet
+    std::atomic<int> hybrid{ -1 };
+
+    static constexpr uint32_t any_cpu = 0xffffffff;
+
+    // current_cpu() cannot tell cpus apart elsewhere, so per-cpu leaves are not cached there.
+    //
+#if defined( _WIN32 ) || defined( __linux__ )
+    static constexpr bool per_cpu_keys = true;
+#else
+    static constexpr bool per_cpu_keys = false;
+#endif
+
+    struct cpu_class_result
+    {
+        uint8_t value;
+        uint32_t cpu;           // cpu the class belongs to, any_cpu off hybrid parts
+        bool usable;            // false: bypass the cache for this query
+    };
+
+    struct slot_key
+    {
+        uint64_t key;           // 0: bypass the cache for this query
+        uint32_t cpu;           // cpu the value must be stored from, any_cpu if it does not matter
+    };
+
+    // class | 1 | subleaf (23 bits) | leaf; bit 55 keeps every key non-zero. Subleaves that do not
+    // fit are never enumerated in practice, and those queries bypass the cache.
+    //
+    static uint64_t make_key( int32_t function_id, int32_t subfunction_id, uint8_t cpu_class )
+    {
+        const auto subleaf = static_cast< uint32_t >( subfunction_id );
+        if ( subleaf >> 23 )
+            return 0;
+
+        return ( uint64_t( cpu_class ) << 56 ) | ( uint64_t( 1 ) << 55 ) | ( uint64_t( subleaf ) << 32 ) | static_cast< uint32_t >( function_id );
+    }
+
+    // Per-cpu leaves: 1 | cpu (10 bits) | subleaf (13 bits) | leaf, with class 0. They never share
+    // a leaf with a class key, so the two layouts cannot collide.
+    //
+    static uint64_t make_cpu_key( int32_t function_id, int32_t subfunction_id, uint32_t cpu )
+    {
+        const auto subleaf = static_cast< uint32_t >( subfunction_id );
+        if ( subleaf >> 13 )
+            return 0;
+
+        return ( uint64_t( 1 ) << 55 ) | ( uint64_t( cpu ) << 45 ) | ( uint64_t( subleaf ) << 32 ) | static_cast< uint32_t >( function_id );
+    }
+
+    slot_key key_for( int32_t function_id, int32_t subfunction_id )
+    {
+        if ( std::ranges::find( per_cpu_leaves, static_cast< uint32_t >( function_id ) ) != std::end( per_cpu_leaves ) )
+        {
+            if constexpr ( !per_cpu_keys )
+                return { 0, any_cpu };
+
+            const uint32_t cpu = current_cpu();
+            if ( cpu >= max_cpus )
+                return { 0, cpu };
+
+            return { make_cpu_key( function_id, subfunction_id, cpu ), cpu };
+        }
+
+        const auto cls = cpu_class();
+        return { cls.usable ? make_key( function_id, subfunction_id, cls.value ) : 0, cls.cpu };
+    }
+
+    static std::size_t hash( uint64_t key )
+    {
+        return static_cast< std::size_t >( ( key * 0x9e3779b97f4a7c15 ) >> ( 64 - slot_bits ) );
+    }
+
+    bool read( slot_entry& slot, int32_t info[ 4 ] )
+    {
+        const uint32_t seq = slot.seq.load( std::memory_order_acquire );
+        if ( seq == 0 || ( seq & 1 ) )
+            return false;
+
+        for ( int i = 0; i < 4; ++i )
+            info[ i ] = slot.regs[ i ].load( std::memory_order_relaxed );
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+        return slot.seq.load( std::memory_order_relaxed ) == seq;
+    }
+
+    // For per-cpu leaves, and for every leaf on hybrid parts, the value is only stored if the
+    // thread is still on the cpu the key was taken from; otherwise one cpu's ids (or an E-core
+    // result) could land under another key. The caller still gets the value, just as it would
+    // without the cache.
+    //
+    // A writer that finds the slot held by another fill or refresh stores nothing and returns
+    // false rather than waiting for it.
+    //
+    bool fill( slot_entry& slot, int32_t info[ 4 ], int32_t function_id, int32_t subfunction_id, uint32_t cpu )
+    {
+        upstream.query( info, function_id, subfunction_id );
+        if ( cpu != any_cpu && current_cpu() != cpu )
+            return false;
+
+        uint32_t seq = slot.seq.load( std::memory_order_relaxed );
+        if ( ( seq & 1 ) || !slot.seq.compare_exchange_strong( seq, seq + 1, std::memory_order_acquire ) )
+            return false;
+
+        std::atomic_thread_fence( std::memory_order_release );
+        for ( int i = 0; i < 4; ++i )
+            slot.regs[ i ].store( info[ i ], std::memory_order_relaxed );
+
+        slot.seq.store( seq + 2, std::memory_order_release );
+        return true;
+    }
+
+    // Core type (leaf 0x1A eax[31:24]) of the calling cpu on hybrid parts, learned once per cpu.
+    // A thread that migrates while leaf 0x1A is issued learns nothing and bypasses the cache.
+    //
+    cpu_class_result cpu_class()
+    {
+        int is_hybrid = hybrid.load( std::memory_order_relaxed );
+        if ( is_hybrid < 0 )
+        {
+            int32_t info[ 4 ];
+            upstream.query( info, 0, 0 );
+            const int32_t max_leaf = info[ 0 ];
+
+            is_hybrid = 0;
+            if ( max_leaf >= 0x1a )
+            {
+                upstream.query( info, 0x07, 0 );
+                is_hybrid = ( info[ 3 ] >> 15 ) & 1;
+            }
+
+            hybrid.store( is_hybrid, std::memory_order_relaxed );
+        }
+
+        if ( !is_hybrid )
+            return { 0, any_cpu, true };
+
+        const uint32_t cpu = current_cpu();
+        if ( cpu >= max_cpus )
+            return { 0, cpu, false };
+
+        uint8_t cls = cpu_classes[ cpu ].load( std::memory_order_relaxed );
+        if ( !cls )
+        {
+            int32_t info[ 4 ];
+            upstream.query( info, 0x1a, 0 );
+            if ( current_cpu() != cpu )
+                return { 0, cpu, false };
+
+            cls = static_cast< uint8_t >( ( static_cast< uint32_t >( info[ 0 ] ) >> 24 ) + 1 );
+            cpu_classes[ cpu ].store( cls, std::memory_order_relaxed );
+        }
+
+        return { static_cast< uint8_t >( cls - 1 ), cpu, true };
+    }
+};
+
+// Single cache for the whole process. enable_cpuid_cache() routes every cpu_query that uses the
+// default backend through it.
+//
+inline cpuid_cache& process_cpuid_cache()
+{
+    static cpuid_cache cache;
+    return cache;
+}
+
+inline void enable_cpuid_cache()
+{
+    set_cpuid_backend( &process_cpuid_cache() );
+}
@@ -0,0 +1,80 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "cpu_affinity.hpp"
+#include "cpuid.hpp"
+#include "tsc.hpp"
+
+// Cycles spent constructing a cpu_query for one leaf/subleaf. Under a hypervisor this is
+// dominated by the VM exit for CPUID.
+//
+struct cpuid_latency
+{
+    uint32_t leaf;
+    uint32_t subleaf;
+    latency_summary cycles;
+};
+
+// Times every leaf for_each_cpuid_leaf issues, samples times each, on a worker pinned to cpu; the
+// caller's own affinity is left alone. The tsc_begin/tsc_end overhead is subtracted from every sample.
+// Only the native backend executes CPUID; any other backend (a cache, a replay) is rejected with an
+// empty result rather than reported as CPUID latency, as is a cpu that cannot be pinned.
+//
+inline std::vector<cpuid_latency> profile_cpuid_leaves( std::size_t samples = 1000, uint32_t cpu = 0, cpuid_backend& backend = native_cpuid_source )
+{
+    std::vector<cpuid_latency> out;
+    if ( &backend != &native_cpuid_source )
+        return out;
+
+    for_each_cpu_parallel( { cpu }, [ & ] ( std::size_t, uint32_t )
+    {
+        std::vector<std::pair<int32_t, int32_t>> leaves;
+        for_each_cpuid_leaf( [ & ] ( cpu_query& leaf ) { leaves.emplace_back( leaf.function_id(), leaf.subfunction_id() ); }, backend );
+
+        const uint64_t overhead = tsc_overhead();
+        out.reserve( leaves.size() );
+
+        std::vector<uint64_t> cycles( samples );
+        for ( const auto& [leaf, subleaf] : leaves )
+        {
+            for ( auto& sample : cycles )
+            {
+                const uint64_t start = tsc_begin();
+                const cpu_query query( leaf, subleaf, backend );
+                const uint64_t elapsed = tsc_end() - start;
+
+                sample = elapsed > overhead ? elapsed - overhead : 0;
+            }
+
+            out.push_back( { static_cast< uint32_t >( leaf ), static_cast< uint32_t >( subleaf ), summarize_latency( cycles ) } );
+        }
+    } );
+
+    return out;
+}
@@ -0,0 +1,165 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "field_ref.hpp"
+
+#if defined( _MSC_VER ) && defined( _M_X64 )
+#include <immintrin.h>
+#define FIELD_DECODE_PEXT
+#define FIELD_DECODE_TARGET_BMI2
+#elif defined( __x86_64__ )
+#include <immintrin.h>
+#define FIELD_DECODE_PEXT
+#define FIELD_DECODE_TARGET_BMI2 __attribute__( ( target( "bmi2" ) ) )
+#endif
+
+// Registers are at most 64 bits wide, so no schema has more than 64 fields.
+//
+constexpr std::size_t max_register_fields = 64;
+
+template <typename Index>
+consteval std::size_t widest_register_schema( const Index& index )
+{
+    std::size_t widest = 0;
+    for ( const auto& entry : index )
+        for ( const auto& reg : entry.second )
+            widest = reg.second.fields.size() > widest ? reg.second.fields.size() : widest;
+    return widest;
+}
+
+static_assert( widest_register_schema( cpuid_schema ) <= max_register_fields, "a cpuid register schema has more fields than decoded_register holds" );
+static_assert( widest_register_schema( msr_schema_list ) <= max_register_fields, "an msr schema has more fields than decoded_register holds" );
+
+// Value of every field of one register, in schema order.
+//
+struct decoded_register
+{
+    uint64_t values[ max_register_fields ];
+    std::size_t count = 0;
+
+    [[nodiscard]] const uint64_t* begin() const { return values; }
+    [[nodiscard]] const uint64_t* end() const { return values + count; }
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] uint64_t operator[]( std::size_t i ) const { return values[ i ]; }
+};
+
+// BMI2 support of the hardware (leaf 7.0 ebx bit 8), read once. Always asks the CPU itself: a
+// replay or emulating backend may report BMI2 on a host that would fault on PEXT.
+//
+inline bool cpu_has_bmi2()
+{
+    static const bool supported = []
+    {
+        if ( cpu_query( 0, 0, native_cpuid_source ).registers()[ eax ] < 7 )
+            return false;
+
+        return cpuid_field_ref<0x07, "ebx", "bmi2">::get( cpu_query( 0x07, 0, native_cpuid_source ) ) != 0;
+    }();
+
+    return supported;
+}
+
+// BMI2 with PEXT in hardware. AMD family 17h (Zen 1/2, and Hygon's family 18h derivative)
+// implements PEXT in microcode, taking a few cycles per set mask bit, so it is slower there than
+// the bit loop it would replace.
+//
+inline bool cpu_has_fast_pext()
+{
+    static const bool fast = []
+    {
+        if ( !cpu_has_bmi2() )
+            return false;
+
+        const auto vendor = static_cast< uint32_t >( cpu_query( 0, 0, native_cpuid_source ).registers()[ ebx ] );
+        const auto version = static_cast< uint32_t >( cpu_query( 1, 0, native_cpuid_source ).registers()[ eax ] );
+        const uint32_t base_family = ( version >> 8 ) & 0xf;
+        const uint32_t family = base_family == 0xf ? base_family + ( ( version >> 20 ) & 0xff ) : base_family;
+
+        constexpr uint32_t authentic_amd = 0x68747541;      // "Auth"
+        constexpr uint32_t hygon_genuine = 0x6f677948;      // "Hygo"
+        return !( ( vendor == authentic_amd && family == 0x17 ) || ( vendor == hygon_genuine && family == 0x18 ) );
+    }();
+
+    return fast;
+}
+
+#if defined( FIELD_DECODE_PEXT )
+FIELD_DECODE_TARGET_BMI2 inline uint64_t extract_bits_pext( uint64_t value, uint64_t mask )
+{
+    return _pext_u64( value, mask );
+}
+#endif
+
+// Gathers the bits of value selected by mask into the low bits of the result, in order. For
+// masks with gaps, e.g. a fleet query over non-adjacent flags; a contiguous field is just a shift
+// and mask and never needs this.
+//
+inline uint64_t extract_bits( uint64_t value, uint64_t mask )
+{
+#if defined( FIELD_DECODE_PEXT )
+    if ( cpu_has_fast_pext() )
+        return extract_bits_pext( value, mask );
+#endif
+
+    uint64_t out = 0;
+    for ( uint64_t bit = 1; mask; mask &= mask - 1, bit <<= 1 )
+        if ( value & mask & ( ~mask + 1 ) )
+            out |= bit;
+    return out;
+}
+
+// Decodes all fields of a register in one pass; out must hold fields.size() values. Schema fields
+// are bit ranges, so each is a shift and mask; a mask with gaps goes through extract_bits. Fields
+// whose bits fall outside the register have a zero mask and decode to 0.
+//
+template <typename Field>
+void decode_fields( uint64_t value, std::span<const Field> fields, uint64_t* out )
+{
+    for ( std::size_t i = 0; i < fields.size(); ++i )
+    {
+        const uint64_t mask = fields[ i ].mask;
+        const uint64_t low = mask >> ( fields[ i ].bit_start & 63 );
+
+        if ( ( low & ( low + 1 ) ) == 0 )
+            out[ i ] = ( value & mask ) >> ( fields[ i ].bit_start & 63 );
+        else
+            out[ i ] = extract_bits( value, mask );
+    }
+}
+
+// Decodes at most max_register_fields fields, which every schema in the databases fits (checked
+// above); a longer caller-supplied span is cut short, and size() says how many were decoded.
+//
+template <typename Field>
+decoded_register decode_register( uint64_t value, std::span<const Field> fields )
+{
+    decoded_register decoded;
+    decoded.count = fields.size() < max_register_fields ? fields.size() : max_register_fields;
+    decode_fields( value, fields.first( decoded.count ), decoded.values );
+    return decoded;
+}
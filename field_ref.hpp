@@ -0,0 +1,114 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+#include "schema_table.hpp"
+#include "cpuid.hpp"
+#include "msr.hpp"
+
+// Field accessors resolved from schema names at compile time:
+//
+//     using avx = cpuid_field_ref<0x1, "ecx", "avx">;
+//     if ( avx::get( leaf_1 ) ) ...
+//
+// The leaf/register/field (or MSR index/field) lookup runs during constant evaluation, so a typo,
+// or a name that matches more than one field, is a compile error and get() is a shift and an AND
+// on the register value.
+//
+
+// Lookups are only ever evaluated at compile time; the throws turn a bad name into a compile error.
+//
+consteval const cpuid_field& resolve_cpuid_field( uint32_t leaf, uint32_t subleaf, std::string_view reg, std::string_view name )
+{
+    const function_schema& schema = find_cpuid_schema( static_cast< int32_t >( leaf ), static_cast< int32_t >( subleaf ) );
+    const auto* entry = schema.find( reg );
+    if ( entry == schema.end() )
+        throw "register has no schema for this cpuid leaf";
+
+    const cpuid_field* match = nullptr;
+    for ( const auto& field : entry->second.fields )
+    {
+        if ( field.name != name )
+            continue;
+        if ( match )
+            throw "field name is ambiguous in this schema";
+        match = &field;
+    }
+
+    if ( !match )
+        throw "field is not in the cpuid register schema";
+    return *match;
+}
+
+consteval const msr_field& resolve_msr_field( uint32_t index, std::string_view name )
+{
+    if ( !msr_schema_known( index ) )
+        throw "msr has no schema";
+
+    const msr_field* match = nullptr;
+    for ( const auto& field : find_msr_schema( index ).begin()->second.fields )
+    {
+        if ( field.name != name )
+            continue;
+        if ( match )
+            throw "field name is ambiguous in this schema";
+        match = &field;
+    }
+
+    if ( !match )
+        throw "field is not in the msr schema";
+    return *match;
+}
+
+template <uint32_t Leaf, fixed_string Reg, fixed_string Field, uint32_t Subleaf = 0>
+struct cpuid_field_ref
+{
+    static constexpr uint32_t leaf = Leaf;
+    static constexpr uint32_t subleaf = Subleaf;
+    static constexpr const cpuid_field& field = resolve_cpuid_field( Leaf, Subleaf, Reg.view(), Field.view() );
+    static constexpr std::size_t reg = cpu_query::to_index( Reg.view() );
+    static constexpr uint32_t shift = static_cast< uint32_t >( field.bit_start );
+    static constexpr uint32_t mask = static_cast< uint32_t >( field.mask >> field.bit_start );
+
+    [[nodiscard]] static constexpr uint32_t get( uint32_t reg_value ) { return ( reg_value >> shift ) & mask; }
+
+    // The query has to be for the same leaf/subleaf; only the register value is read.
+    //
+    [[nodiscard]] static uint32_t get( const cpu_query& query ) { return get( static_cast< uint32_t >( query.registers()[ reg ] ) ); }
+};
+
+template <uint32_t Index, fixed_string Field>
+struct msr_field_ref
+{
+    static constexpr uint32_t index = Index;
+    static constexpr const msr_field& field = resolve_msr_field( Index, Field.view() );
+    static constexpr uint32_t shift = static_cast< uint32_t >( field.bit_start );
+    static constexpr uint64_t mask = field.mask >> field.bit_start;
+
+    [[nodiscard]] static constexpr uint64_t get( uint64_t msr_value ) { return ( msr_value >> shift ) & mask; }
+
+    [[nodiscard]] static uint64_t get( const msr_query& query ) { return get( query.msr_data ); }
+};
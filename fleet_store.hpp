@@ -0,0 +1,226 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "field_ref.hpp"
+#include "snapshot.hpp"
+
+// Values of one register across the fleet; row i is host i. Columns only grow as far as the last
+// host that has the register, so rows past the end are simply not present.
+//
+struct fleet_column
+{
+    std::vector<uint64_t> values;       // 0 where the host has no value
+    std::vector<uint8_t> present;       // 1 where the host read the register successfully
+};
+
+// Field of every row of a column; out must hold column.values.size() values.
+//
+inline void extract_field( const fleet_column& column, uint64_t mask, uint32_t shift, uint64_t* out )
+{
+    const uint64_t* values = column.values.data();
+    const std::size_t rows = column.values.size();
+
+    for ( std::size_t i = 0; i < rows; ++i )
+        out[ i ] = ( values[ i ] & mask ) >> shift;
+}
+
+// Compares one field of every row with value. The loops are branch-free over contiguous arrays
+// so the compiler vectorizes them; mask/shift come from the schema (see field_ref.hpp).
+//
+inline std::size_t count_where( const fleet_column& column, uint64_t mask, uint32_t shift, uint64_t value )
+{
+    const uint64_t expected = ( value << shift ) & mask;
+    const uint64_t* values = column.values.data();
+    const uint8_t* present = column.present.data();
+    const std::size_t rows = column.values.size();
+
+    std::size_t count = 0;
+    for ( std::size_t i = 0; i < rows; ++i )
+        count += present[ i ] & ( ( values[ i ] & mask ) == expected );
+
+    return count;
+}
+
+// Rows whose field equals value. Matches are computed a block at a time into a byte mask and
+// then compacted, so the comparison loop stays branch-free.
+//
+inline std::vector<uint32_t> rows_where( const fleet_column& column, uint64_t mask, uint32_t shift, uint64_t value )
+{
+    constexpr std::size_t block = 1024;
+
+    const uint64_t expected = ( value << shift ) & mask;
+    const uint64_t* values = column.values.data();
+    const uint8_t* present = column.present.data();
+    const std::size_t rows = column.values.size();
+
+    std::vector<uint32_t> out;
+    uint8_t matches[ block ];
+
+    for ( std::size_t first = 0; first < rows; first += block )
+    {
+        const std::size_t n = rows - first < block ? rows - first : block;
+
+        for ( std::size_t i = 0; i < n; ++i )
+            matches[ i ] = present[ first + i ] & ( ( values[ first + i ] & mask ) == expected );
+
+        for ( std::size_t i = 0; i < n; ++i )
+            if ( matches[ i ] )
+                out.push_back( static_cast< uint32_t >( first + i ) );
+    }
+
+    return out;
+}
+
+// Columnar store of CPUID/MSR values across many hosts: one row per host, one column per MSR
+// index and per CPUID (leaf, subleaf, register). A fleet-wide field query is a scan of one column.
+//
+struct fleet_store
+{
+    std::vector<std::string> hosts;
+    std::vector<fleet_column> columns;
+    std::vector<uint32_t> msr_slot_columns = std::vector<uint32_t>( msr_slot_count, no_column );
+    std::unordered_map<uint32_t, uint32_t> msr_columns;         // indices outside the MSR ranges
+    std::unordered_map<uint64_t, uint32_t> cpuid_columns;
+
+    static constexpr uint32_t no_column = 0xffffffff;
+
+    // leaf (32 bits) | subleaf (30 bits) | reg (2 bits). Subleaves are masked so they can never
+    // spill into the leaf; enumeration stops far below 2^30 (max_cpuid_subleaf).
+    //
+    static constexpr uint64_t cpuid_key( uint32_t leaf, uint32_t subleaf, std::size_t reg )
+    {
+        return ( uint64_t( leaf ) << 32 ) | ( uint64_t( subleaf & 0x3fffffff ) << 2 ) | ( reg & 3 );
+    }
+
+    [[nodiscard]] std::size_t size() const { return hosts.size(); }
+
+    // Adds one cpu of a snapshot as a row (normally cpu 0, since SKU-wide values match across
+    // cores). Only the columns this host has are touched.
+    //
+    uint32_t add_host( std::string name, const snapshot_view& snapshot, uint32_t cpu = 0 )
+    {
+        const auto row = static_cast< uint32_t >( hosts.size() );
+        hosts.push_back( std::move( name ) );
+
+        const auto* entry = snapshot.find_cpu( cpu );
+        if ( !entry )
+            return row;
+
+        for ( const auto& leaf : snapshot.cpuid_of( *entry ) )
+            for ( std::size_t reg = 0; reg < 4; ++reg )
+                set( column_for( cpuid_columns, cpuid_key( leaf.leaf, leaf.subleaf, reg ) ), row, leaf.regs[ reg ] );
+
+        for ( const auto& msr : snapshot.msrs_of( *entry ) )
+            if ( msr.status == msr_ok )
+                set( msr_column_for( msr.index ), row, msr.value );
+
+        return row;
+    }
+
+    [[nodiscard]] const fleet_column* msr_column( uint32_t index ) const
+    {
+        if ( const uint32_t slot = msr_index_to_slot( index ); slot != msr_invalid_slot )
+            return msr_slot_columns[ slot ] != no_column ? &columns[ msr_slot_columns[ slot ] ] : nullptr;
+
+        const auto search = msr_columns.find( index );
+        return search != msr_columns.end() ? &columns[ search->second ] : nullptr;
+    }
+
+    [[nodiscard]] const fleet_column* cpuid_column( uint32_t leaf, uint32_t subleaf, std::size_t reg ) const
+    {
+        const auto search = cpuid_columns.find( cpuid_key( leaf, subleaf, reg ) );
+        return search != cpuid_columns.end() ? &columns[ search->second ] : nullptr;
+    }
+
+    // Column of a compile-time field accessor: msr_field_ref<...> or cpuid_field_ref<...>.
+    //
+    template <typename FieldRef>
+    [[nodiscard]] const fleet_column* column_of() const
+    {
+        if constexpr ( requires { FieldRef::index; } )
+            return msr_column( FieldRef::index );
+        else
+            return cpuid_column( FieldRef::leaf, FieldRef::subleaf, FieldRef::reg );
+    }
+
+    // e.g. hosts_where<msr_field_ref<0x48, "indirect_branch_restricted_speculation_ibrs">>( 1 )
+    //
+    template <typename FieldRef>
+    [[nodiscard]] std::vector<uint32_t> hosts_where( uint64_t value ) const
+    {
+        const auto* column = column_of<FieldRef>();
+        return column ? rows_where( *column, uint64_t( FieldRef::mask ) << FieldRef::shift, FieldRef::shift, value ) : std::vector<uint32_t>{};
+    }
+
+    template <typename FieldRef>
+    [[nodiscard]] std::size_t count_hosts_where( uint64_t value ) const
+    {
+        const auto* column = column_of<FieldRef>();
+        return column ? count_where( *column, uint64_t( FieldRef::mask ) << FieldRef::shift, FieldRef::shift, value ) : 0;
+    }
+
+    private:
+    template <typename Key>
+    fleet_column& column_for( std::unordered_map<Key, uint32_t>& lookup, Key key )
+    {
+        const auto [it, inserted] = lookup.try_emplace( key, static_cast< uint32_t >( columns.size() ) );
+        if ( inserted )
+            columns.emplace_back();
+
+        return columns[ it->second ];
+    }
+
+    fleet_column& msr_column_for( uint32_t index )
+    {
+        const uint32_t slot = msr_index_to_slot( index );
+        if ( slot == msr_invalid_slot )
+            return column_for( msr_columns, index );
+
+        if ( msr_slot_columns[ slot ] == no_column )
+        {
+            msr_slot_columns[ slot ] = static_cast< uint32_t >( columns.size() );
+            columns.emplace_back();
+        }
+
+        return columns[ msr_slot_columns[ slot ] ];
+    }
+
+    static void set( fleet_column& column, uint32_t row, uint64_t value )
+    {
+        if ( column.values.size() <= row )
+        {
+            column.values.resize( row + 1 );
+            column.present.resize( row + 1 );
+        }
+
+        column.values[ row ] = value;
+        column.present[ row ] = 1;
+    }
+};
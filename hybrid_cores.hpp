@@ -0,0 +1,170 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "cpu_affinity.hpp"
+#include "cpu_topology.hpp"
+#include "cpuid.hpp"
+#include "field_ref.hpp"
+
+// Leaf 0x1A eax[31:24]. core_type_none is used for every cpu of a non-hybrid part.
+//
+enum e_core_type
+{
+    core_type_none = 0x00,
+    core_type_atom = 0x20,      // E-core
+    core_type_core = 0x40       // P-core
+};
+
+inline const char* core_type_name( uint32_t core_type )
+{
+    switch ( core_type )
+    {
+        case core_type_none: return "none";
+        case core_type_atom: return "atom";
+        case core_type_core: return "core";
+        default: return "unknown";
+    }
+}
+
+struct cpu_core_type
+{
+    uint32_t cpu;
+    uint32_t core_type;
+    uint32_t native_model_id;
+};
+
+// Every cpu of one core type. cores has one set per physical core (its SMT siblings), and
+// primary_threads holds the lowest cpu of each of those cores, for placing threads that should
+// not share a core with each other.
+//
+struct core_type_group
+{
+    uint32_t core_type;
+    uint32_t native_model_id;
+    cpu_set cpus;
+    std::vector<cpu_set> cores;
+    cpu_set primary_threads;
+};
+
+struct hybrid_cores
+{
+    bool hybrid = false;
+    std::vector<cpu_core_type> cpus;        // ascending by cpu
+    std::vector<core_type_group> groups;    // ascending by core type
+
+    [[nodiscard]] const core_type_group* find( uint32_t core_type ) const
+    {
+        const auto it = std::ranges::find( groups, core_type, &core_type_group::core_type );
+        return it != groups.end() ? &*it : nullptr;
+    }
+
+    [[nodiscard]] uint32_t core_type_of( uint32_t cpu ) const
+    {
+        const auto it = std::ranges::lower_bound( cpus, cpu, {}, &cpu_core_type::cpu );
+        return ( it != cpus.end() && it->cpu == cpu ) ? it->core_type : static_cast< uint32_t >( core_type_none );
+    }
+
+    // P-cores on a hybrid part, every cpu otherwise, so callers need no special case.
+    //
+    [[nodiscard]] cpu_set performance_cpus() const
+    {
+        const auto* group = find( hybrid ? core_type_core : core_type_none );
+        return group ? group->cpus : cpu_set{};
+    }
+
+    [[nodiscard]] cpu_set efficiency_cpus() const
+    {
+        const auto* group = find( core_type_atom );
+        return group ? group->cpus : cpu_set{};
+    }
+};
+
+// Issues leaf 0x1A pinned to every cpu of the topology, in parallel, and groups the cpus by core
+// type. Whether the part is hybrid at all comes from leaf 7 edx[15]; if it is not, leaf 0x1A is
+// never issued, no worker is started, and all cpus land in one core_type_none group. As with
+// build_cpu_topology, the default backend is the raw instruction because cached results are not
+// per cpu. A cpu that cannot be pinned is also left as core_type_none.
+//
+inline hybrid_cores classify_hybrid_cores( const cpu_topology& topology, cpuid_backend& backend = native_cpuid_source )
+{
+    using max_leaf = cpuid_field_ref<0x0, "eax", "max_input_value_cpuid">;
+    using hybrid_flag = cpuid_field_ref<0x7, "edx", "hybrid">;
+    using core_type = cpuid_field_ref<0x1a, "eax", "core_type">;
+    using native_model_id = cpuid_field_ref<0x1a, "eax", "native_model_id">;
+
+    hybrid_cores result;
+    result.hybrid = max_leaf::get( cpu_query( 0x0, 0, backend ) ) >= 0x1a && hybrid_flag::get( cpu_query( 0x7, 0, backend ) );
+
+    std::vector<uint32_t> cpus;
+    for ( const auto& location : topology.cpus )
+        cpus.push_back( location.cpu );
+
+    for ( const auto cpu : cpus )
+        result.cpus.push_back( { cpu, core_type_none, 0 } );
+
+    if ( result.hybrid )
+    {
+        for_each_cpu_parallel( cpus, [ & ] ( std::size_t slot, uint32_t cpu )
+        {
+            const cpu_query leaf_1a( 0x1a, 0, backend );
+            result.cpus[ slot ] = { cpu, core_type::get( leaf_1a ), native_model_id::get( leaf_1a ) };
+        } );
+    }
+
+    std::map<uint32_t, core_type_group> groups;
+    std::map<std::pair<uint32_t, uint32_t>, cpu_set> cores;     // ( core type, core id ) -> siblings
+
+    for ( std::size_t slot = 0; slot < cpus.size(); ++slot )
+    {
+        const auto& entry = result.cpus[ slot ];
+        auto [it, inserted] = groups.try_emplace( entry.core_type );
+        if ( inserted )
+            it->second = { entry.core_type, entry.native_model_id, {}, {}, {} };
+
+        it->second.cpus.insert( entry.cpu );
+        cores[ { entry.core_type, topology.cpus[ slot ].ids[ topology_core ] } ].insert( entry.cpu );
+    }
+
+    for ( auto& [key, siblings] : cores )
+    {
+        auto& group = groups[ key.first ];
+        group.primary_threads.insert( siblings.to_vector().front() );
+        group.cores.push_back( std::move( siblings ) );
+    }
+
+    for ( auto& [type, group] : groups )
+        result.groups.push_back( std::move( group ) );
+
+    return result;
+}
+
+inline hybrid_cores classify_hybrid_cores()
+{
+    return classify_hybrid_cores( build_cpu_topology() );
+}
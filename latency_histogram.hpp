@@ -0,0 +1,105 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// HDR-style log-linear histogram of cycle counts. Values below 32 get exact buckets; above that
+// every power of two is split into 16 buckets, so any recorded value is reported to within
+// 1/16 (6.25%) of itself while the whole 64-bit range fits in under 1000 counters.
+//
+struct latency_histogram
+{
+    static constexpr std::size_t sub_buckets = 16;
+    static constexpr std::size_t bucket_count = ( 64 - 5 ) * sub_buckets + 2 * sub_buckets;
+
+    std::array<uint64_t, bucket_count> counts{};
+    uint64_t total = 0;
+    uint64_t min = ~uint64_t( 0 );
+    uint64_t max = 0;
+
+    static constexpr std::size_t bucket_of( uint64_t value )
+    {
+        if ( value < 2 * sub_buckets )
+            return static_cast< std::size_t >( value );
+
+        const std::size_t shift = std::bit_width( value ) - 5;
+        return shift * sub_buckets + static_cast< std::size_t >( value >> shift );
+    }
+
+    // Smallest value that lands in bucket.
+    //
+    static constexpr uint64_t bucket_floor( std::size_t bucket )
+    {
+        if ( bucket < 2 * sub_buckets )
+            return bucket;
+
+        const std::size_t shift = bucket / sub_buckets - 1;
+        return uint64_t( bucket - shift * sub_buckets ) << shift;
+    }
+
+    void record( uint64_t value )
+    {
+        ++counts[ bucket_of( value ) ];
+        ++total;
+        min = std::min( min, value );
+        max = std::max( max, value );
+    }
+
+    void merge( const latency_histogram& other )
+    {
+        for ( std::size_t i = 0; i < bucket_count; ++i )
+            counts[ i ] += other.counts[ i ];
+
+        total += other.total;
+        min = std::min( min, other.min );
+        max = std::max( max, other.max );
+    }
+
+    // Value at or below which percentile% of the recordings fall, e.g. 50.0 or 99.9.
+    //
+    [[nodiscard]] uint64_t value_at( double percentile ) const
+    {
+        if ( !total )
+            return 0;
+
+        const auto rank = static_cast< uint64_t >( percentile / 100.0 * double( total - 1 ) ) + 1;
+        uint64_t seen = 0;
+
+        for ( std::size_t i = 0; i < bucket_count; ++i )
+        {
+            seen += counts[ i ];
+            if ( seen >= rank )
+                return std::clamp( bucket_floor( i ), min, max );
+        }
+
+        return max;
+    }
+};
+
+static_assert( latency_histogram::bucket_of( ~uint64_t( 0 ) ) == latency_histogram::bucket_count - 1 );
+static_assert( latency_histogram::bucket_floor( latency_histogram::bucket_of( 1000 ) ) <= 1000 );
@@ -0,0 +1,289 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "msr_backend.hpp"
+#include "msr_sweep.hpp"
+#include "snapshot.hpp"
+
+// Streaming reader for legacy [[EXECUTION REPORT]] (.lxx) MSR logs. Every string_view handed
+// out points into the input buffer; nothing is copied. Recognized lines:
+//
+//   [[EXECUTION REPORT]]                       starts a report (cpu resets to 0)
+//   ## CPU [3]                                 cpu for the records that follow
+//   [ 1C ] #GP(0)                              faulted index
+//   [ 1C ] NO ACCESS                           unreadable index
+//   [ia32_apic_base | 1B] {FEE00C00h}          register header
+//   bsp_flag {    8:8    }     = 0h            field of the preceding header
+//
+struct lxx_field
+{
+    std::string_view name;
+    uint32_t bit_start;
+    uint32_t bit_end;
+    uint64_t value;
+};
+
+struct lxx_record
+{
+    uint32_t cpu;
+    uint32_t index;
+    e_msr_status status;
+    uint64_t value;
+    std::string_view name;              // empty for faulted / unreadable indices
+    std::span<const lxx_field> fields;  // valid until the next call to next()
+};
+
+struct lxx_parser
+{
+    explicit lxx_parser( std::string_view text ) : text( text ) {}
+    explicit lxx_parser( std::span<const std::byte> bytes )
+        : text( reinterpret_cast< const char* >( bytes.data() ), bytes.size() ) {}
+
+    std::size_t reports = 0;
+    std::size_t malformed_lines = 0;
+
+    // Advances to the next MSR record; false at end of input.
+    //
+    bool next( lxx_record& record )
+    {
+        fields.clear();
+        bool have_record = false;
+
+        while ( pos < text.size() )
+        {
+            const std::size_t line_start = pos;
+            std::string_view line = next_line();
+
+            std::size_t indent = 0;
+            while ( indent < line.size() && line[ indent ] == ' ' )
+                ++indent;
+            line.remove_prefix( indent );
+
+            if ( line.empty() )
+                continue;
+
+            if ( line.front() != '[' && line.front() != '#' )
+            {
+                lxx_field field{};
+                if ( !have_record || !parse_field( line, field ) )
+                    ++malformed_lines;
+                else
+                    fields.push_back( field );
+                continue;
+            }
+
+            // Any non-field line ends the record being built; rewind so it is seen next time.
+            //
+            if ( have_record )
+            {
+                pos = line_start;
+                break;
+            }
+
+            if ( line == "[[EXECUTION REPORT]]" )
+            {
+                ++reports;
+                cpu = 0;
+                continue;
+            }
+
+            if ( line.starts_with( "## CPU [" ) )
+            {
+                line.remove_prefix( 8 );
+                if ( !parse_number( line, cpu, 10 ) )
+                    ++malformed_lines;
+                continue;
+            }
+
+            if ( parse_header( line, record ) )
+            {
+                record.cpu = cpu;
+                have_record = true;
+
+                if ( record.status != msr_ok )
+                    break;
+                continue;
+            }
+
+            ++malformed_lines;
+        }
+
+        record.fields = fields;
+        return have_record;
+    }
+
+    private:
+    std::string_view next_line()
+    {
+        const char* begin = text.data() + pos;
+        const std::size_t remaining = text.size() - pos;
+        const void* eol = std::memchr( begin, '\n', remaining );
+
+        std::size_t len = eol ? static_cast< std::size_t >( static_cast< const char* >( eol ) - begin ) : remaining;
+        pos += eol ? len + 1 : len;
+
+        if ( len && begin[ len - 1 ] == '\r' )
+            --len;
+
+        return { begin, len };
+    }
+
+    template <typename T>
+    static bool parse_number( std::string_view& s, T& out, int base = 16 )
+    {
+        const auto [ptr, ec] = std::from_chars( s.data(), s.data() + s.size(), out, base );
+        if ( ec != std::errc{} )
+            return false;
+
+        s.remove_prefix( static_cast< std::size_t >( ptr - s.data() ) );
+        return true;
+    }
+
+    static void skip_spaces( std::string_view& s )
+    {
+        while ( !s.empty() && s.front() == ' ' )
+            s.remove_prefix( 1 );
+    }
+
+    static bool expect( std::string_view& s, char c )
+    {
+        skip_spaces( s );
+        if ( s.empty() || s.front() != c )
+            return false;
+
+        s.remove_prefix( 1 );
+        return true;
+    }
+
+    // "[ 1C ] #GP(0)" or "[name | 1B] {FEE00C00h}"
+    //
+    static bool parse_header( std::string_view line, lxx_record& record )
+    {
+        line.remove_prefix( 1 );
+        skip_spaces( line );
+
+        record.name = {};
+        record.value = 0;
+
+        const auto bar = line.find( '|' );
+        if ( bar == std::string_view::npos )
+        {
+            if ( !parse_number( line, record.index ) || !expect( line, ']' ) )
+                return false;
+
+            skip_spaces( line );
+            if ( line.starts_with( "#GP" ) )
+                record.status = msr_gp_fault;
+            else if ( line.starts_with( "NO ACCESS" ) )
+                record.status = msr_no_access;
+            else
+                return false;
+
+            return true;
+        }
+
+        std::string_view name = line.substr( 0, bar );
+        while ( !name.empty() && name.back() == ' ' )
+            name.remove_suffix( 1 );
+
+        line.remove_prefix( bar + 1 );
+        skip_spaces( line );
+
+        if ( !parse_number( line, record.index ) || !expect( line, ']' ) || !expect( line, '{' ) ||
+             !parse_number( line, record.value ) )
+            return false;
+
+        record.name = name;
+        record.status = msr_ok;
+        return true;
+    }
+
+    // "bsp_flag {    8:8    }               = 0h"
+    //
+    static bool parse_field( std::string_view line, lxx_field& field )
+    {
+        const auto brace = line.find( '{' );
+        if ( brace == std::string_view::npos )
+            return false;
+
+        std::string_view name = line.substr( 0, brace );
+        while ( !name.empty() && name.back() == ' ' )
+            name.remove_suffix( 1 );
+
+        line.remove_prefix( brace + 1 );
+        skip_spaces( line );
+
+        if ( !parse_number( line, field.bit_start, 10 ) || !expect( line, ':' ) ||
+             !parse_number( line, field.bit_end, 10 ) || !expect( line, '}' ) || !expect( line, '=' ) )
+            return false;
+
+        skip_spaces( line );
+        if ( !parse_number( line, field.value ) )
+            return false;
+
+        field.name = name;
+        return true;
+    }
+
+    std::string_view text;
+    std::size_t pos = 0;
+    uint32_t cpu = 0;
+    std::vector<lxx_field> fields;
+};
+
+// Converts an archived report into a snapshot so it can be stored, diffed and queried like a
+// live capture. The demo logs cover msr_sweep_ranges, so those are recorded as swept.
+//
+inline bool import_lxx( const std::string& path, snapshot_builder& builder,
+                        std::span<const msr_range> swept = msr_sweep_ranges )
+{
+    mapped_file file( path );
+    if ( !file.is_open() )
+        return false;
+
+    lxx_parser parser( file.bytes() );
+    msr_sweep_table table;
+    lxx_record record{};
+
+    while ( parser.next( record ) )
+    {
+        auto it = std::ranges::lower_bound( table.cpus, record.cpu, {}, &msr_sweep_result::cpu );
+        if ( it == table.cpus.end() || it->cpu != record.cpu )
+            it = table.cpus.insert( it, msr_sweep_result{ record.cpu, {} } );
+
+        it->records.push_back( { record.index, record.status, record.value } );
+    }
+
+    builder.add_msr_sweep( table, swept );
+    return parser.reports > 0;
+}
@@ -0,0 +1,131 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+#include <utility>
+
+#if defined( _WIN32 )
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only, move-only view of a whole file mapped into memory. An empty file or any failure
+// leaves the object empty; callers check is_open().
+//
+struct mapped_file
+{
+    mapped_file() = default;
+
+    explicit mapped_file( const std::string& path )
+    {
+#if defined( _WIN32 )
+        HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+        if ( file == INVALID_HANDLE_VALUE )
+            return;
+
+        LARGE_INTEGER file_size{};
+        if ( GetFileSizeEx( file, &file_size ) && file_size.QuadPart > 0 )
+        {
+            HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+            if ( mapping )
+            {
+                base = static_cast< const std::byte* >( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+                if ( base )
+                    size = static_cast< std::size_t >( file_size.QuadPart );
+                CloseHandle( mapping );
+            }
+        }
+        CloseHandle( file );
+#else
+        const int fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+        if ( fd < 0 )
+            return;
+
+        struct stat st{};
+        if ( fstat( fd, &st ) == 0 && st.st_size > 0 )
+        {
+            void* view = mmap( nullptr, static_cast< std::size_t >( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+            if ( view != MAP_FAILED )
+            {
+                base = static_cast< const std::byte* >( view );
+                size = static_cast< std::size_t >( st.st_size );
+                madvise( view, size, MADV_SEQUENTIAL );
+            }
+        }
+        close( fd );
+#endif
+    }
+
+    mapped_file( const mapped_file& ) = delete;
+    mapped_file& operator=( const mapped_file& ) = delete;
+
+    mapped_file( mapped_file&& other ) noexcept
+        : base( std::exchange( other.base, nullptr ) ), size( std::exchange( other.size, 0 ) )
+    {
+    }
+
+    mapped_file& operator=( mapped_file&& other ) noexcept
+    {
+        if ( this != &other )
+        {
+            unmap();
+            base = std::exchange( other.base, nullptr );
+            size = std::exchange( other.size, 0 );
+        }
+        return *this;
+    }
+
+    ~mapped_file() { unmap(); }
+
+    [[nodiscard]] bool is_open() const noexcept { return base != nullptr; }
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return { base, size }; }
+
+    private:
+    void unmap() noexcept
+    {
+        if ( !base )
+            return;
+
+#if defined( _WIN32 )
+        UnmapViewOfFile( base );
+#else
+        munmap( const_cast< std::byte* >( base ), size );
+#endif
+        base = nullptr;
+        size = 0;
+    }
+
+    const std::byte* base = nullptr;
+    std::size_t size = 0;
+};
@@ -22,79 +22,98 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <array>
-#include <intrin.h>
 #include <ranges>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "bitfield.hpp"
+#include "msr_backend.hpp"
 #include "msr_schema.hpp"
 
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+// Terminates on a schema invariant violation: __fastfail on MSVC, a trap everywhere else.
+//
+[[noreturn]] inline void msr_fail( [[maybe_unused]] unsigned int code )
+{
+#if defined( _MSC_VER )
+    __fastfail( code );
+#else
+    __builtin_trap();
+#endif
+}
+
+constexpr const msr_schema_map& find_msr_schema( uint32_t index )
+{
+    const uint32_t slot = msr_index_to_slot( index );
+    if ( slot != msr_invalid_slot )
+        return *msr_schema_refs[ msr_schema_slots[ slot ] ];
+
+    // Indices outside the swept ranges are rare; fall back to the sorted list.
+    //
+    const auto search = msr_schema_list.find( index );
+    return search != msr_schema_list.end() ? search->second : msr_schema_invalid;
+}
+
 struct msr_query
 {
     uint32_t msr_index;
-    msr_schema_map schema;
+    uint32_t cpu;
+    msr_backend* backend;
+    const msr_schema_map* schema;
 
     uint64_t msr_data;
+    e_msr_status status;
     bitfield<uint64_t> bf;
 
     auto rdmsr( uint32_t idx )
     {
-        __try { msr_data = __readmsr( idx ); }
-        __except ( 1 ) { msr_data = 0; }
+        status = backend->read( cpu, idx, msr_data );
+        if ( status != msr_ok )
+            msr_data = 0;
 
         return msr_data;
     }
 
-    explicit msr_query( uint32_t index ) : msr_index( index )
+    explicit msr_query( uint32_t index, uint32_t cpu = 0, msr_backend& backend = get_msr_backend() )
+        : msr_index( index ), cpu( cpu ), backend( &backend ), schema( &find_msr_schema( index ) )
     {
         msr_data = rdmsr( index );
 
-        const auto search = msr_schema_list.find( index );
-        if ( search != msr_schema_list.end() )
-            schema = search->second;
-        else
-        {
-            if ( index >= 0x40000000 && index <= 0x400000ff )
-                schema = reserved_msr_address_space;
-            else
-                schema = msr_schema_invalid;
-        }
-
         bf = bitfield( msr_data );
     }
 
+    // False for both #GP and no-access reads; check status to tell them apart.
+    //
+    [[nodiscard]] bool supported() const noexcept { return status == msr_ok; }
+
     struct field_value
     {
         std::string field_name;
         uint64_t value;
     };
 
-    field_value get_by_name_index( const std::pair<std::string, std::size_t>& p ) noexcept
+    field_value get_by_name_index( const std::pair<std::string_view, std::size_t>& p ) noexcept
     {
-        const msr_schema& reg_schema = schema.at( p.first );
+        const msr_schema& reg_schema = schema->at( p.first );
         const msr_field& field = reg_schema.fields[ p.second ];
-        const uint64_t reg_value = msr_data;
-        if ( field.bit_start == field.bit_end )
-        {
-            return { field.name, uint64_t( reg_value >> field.bit_start ) & 1 };
-        }
-        uint32_t mask = ( ( 1U << ( field.bit_end - field.bit_start + 1 ) ) - 1 ) << field.bit_start;
-        return { field.name, ( reg_value & mask ) >> field.bit_start };
+        return { std::string( field.name ), ( msr_data & field.mask ) >> ( field.bit_start & 63 ) };
     }
 
-    auto& get_bitfield( const std::string& reg_name ) { return bf; }
+    auto& get_bitfield( std::string_view reg_name ) { return bf; }
     auto operator[]( size_t index ) { return bf[ index ]; }
 
     uint64_t get_bit( std::size_t bit_position ) noexcept { return bf[ bit_position ]; }
 
     uint64_t get_bit_range( std::size_t bit_start, std::size_t bit_end ) noexcept
     {
-        uint64_t result = 0;
-        for ( std::size_t i = bit_start; i <= bit_end; ++i )
-            result |= ( get_bit( i ) << ( i - bit_start ) );
-
-        return result;
+        return ( msr_data & field_mask( bit_start, bit_end ) ) >> ( bit_start & 63 );
     }
 
     auto find_field_iter( const msr_schema& reg_schema, auto predicate ) noexcept
@@ -102,14 +121,14 @@ struct msr_query
         const auto field_iter = std::find_if( reg_schema.fields.begin(), reg_schema.fields.end(), predicate );
 
         if ( field_iter == reg_schema.fields.end() )
-            __fastfail( 0x13378 );
+            msr_fail( 0x13378 );
 
         return field_iter;
     }
 
     bitfield<uint64_t>::proxy_range get_field( const char* field_name ) noexcept
     {
-        for ( const auto& reg_schema : schema | std::views::values )
+        for ( const auto& reg_schema : *schema | std::views::values )
         {
             const auto field_iter = find_field_iter( reg_schema, [ &field_name ] ( const msr_field& field )
             {
@@ -122,32 +141,34 @@ struct msr_query
             }
         }
 
-        __fastfail( 0x13379 );
+        msr_fail( 0x13379 );
     }
 
     field_value get_field( std::pair<std::size_t, std::size_t> bit_range ) noexcept
     {
-        const msr_schema& reg_schema = schema.begin()->second; // Adjust this if necessary
+        const msr_schema& reg_schema = schema->begin()->second; // Adjust this if necessary
         const auto field_iter = find_field_iter( reg_schema, [ &bit_range ] ( const msr_field& field )
         {
             return field.bit_start == bit_range.first && field.bit_end == bit_range.second;
         } );
 
         const uint64_t value = get_bit_range( bit_range.first, bit_range.second );
-        return { field_iter->name, value };
+        return { std::string( field_iter->name ), value };
     }
 
     field_value get_field( std::size_t bit_pos ) noexcept
     {
-        const msr_schema& reg_schema = schema.begin()->second; // Adjust this if necessary
+        const msr_schema& reg_schema = schema->begin()->second; // Adjust this if necessary
         const auto field_iter = find_field_iter( reg_schema, [ &bit_pos ] ( const msr_field& field )
         {
             return field.bit_start == bit_pos && field.bit_end == bit_pos;
         } );
 
         const uint64_t value = get_bit( bit_pos );
-        return { field_iter->name, value };
+        return { std::string( field_iter->name ), value };
     }
 
-    const msr_schema_map& get_schema() const noexcept { return schema; }
+    const msr_schema_map& get_schema() const noexcept { return *schema; }
 };
+
+static_assert( std::is_trivially_copyable_v<msr_query> );
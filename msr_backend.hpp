@@ -0,0 +1,199 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#elif defined( __linux__ )
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Outcome of a single RDMSR. msr_gp_fault is the "#GP(0)" state shown in the .lxx reports;
+// msr_no_access means the read could not be attempted at all (no driver, no privilege,
+// offline cpu) and says nothing about whether the register exists.
+//
+enum e_msr_status
+{
+    msr_ok = 0,
+    msr_gp_fault = 1,
+    msr_no_access = 2
+};
+
+struct msr_backend
+{
+    virtual ~msr_backend() = default;
+    virtual e_msr_status read( uint32_t cpu, uint32_t index, uint64_t& value ) = 0;
+};
+
+#if defined( _MSC_VER )
+
+// Kernel-mode only; reads execute on whatever processor the caller is running on,
+// so the cpu argument is ignored and the caller is expected to have set affinity.
+//
+struct intrinsic_msr_backend final : msr_backend
+{
+    e_msr_status read( uint32_t, uint32_t index, uint64_t& value ) override
+    {
+        __try
+        {
+            value = __readmsr( index );
+            return msr_ok;
+        }
+        __except ( 1 )
+        {
+            value = 0;
+            return msr_gp_fault;
+        }
+    }
+};
+
+using native_msr_backend = intrinsic_msr_backend;
+
+#elif defined( __linux__ )
+
+// User-mode backend over the msr driver (/dev/cpu/N/msr). One descriptor per cpu is opened on
+// first use and kept for the lifetime of the backend, so a sweep costs one pread per register.
+// Slots are claimed with a CAS so concurrent per-cpu workers can share a single instance.
+// A failed open is retried after open_retry_interval rather than remembered, so a long-running
+// process picks the driver up after `modprobe msr` or recovers from a transient EMFILE/EBUSY.
+//
+struct dev_msr_backend final : msr_backend
+{
+    static constexpr int fd_unopened = -1;
+    static constexpr int fd_unavailable = -2;
+    static constexpr std::chrono::seconds open_retry_interval{ 1 };
+
+    dev_msr_backend()
+        : cpu_count( static_cast< uint32_t >( sysconf( _SC_NPROCESSORS_CONF ) ) ),
+          fds( std::make_unique<std::atomic<int>[]>( cpu_count ) ),
+          retry_at( std::make_unique<std::atomic<int64_t>[]>( cpu_count ) )
+    {
+        for ( uint32_t i = 0; i < cpu_count; ++i )
+        {
+            fds[ i ].store( fd_unopened, std::memory_order_relaxed );
+            retry_at[ i ].store( 0, std::memory_order_relaxed );
+        }
+    }
+
+    dev_msr_backend( const dev_msr_backend& ) = delete;
+    dev_msr_backend& operator=( const dev_msr_backend& ) = delete;
+
+    ~dev_msr_backend() override
+    {
+        for ( uint32_t i = 0; i < cpu_count; ++i )
+        {
+            const int fd = fds[ i ].load( std::memory_order_relaxed );
+            if ( fd >= 0 )
+                close( fd );
+        }
+    }
+
+    e_msr_status read( uint32_t cpu, uint32_t index, uint64_t& value ) override
+    {
+        value = 0;
+
+        const int fd = get_fd( cpu );
+        if ( fd < 0 )
+            return msr_no_access;
+
+        const ssize_t rd = pread( fd, &value, sizeof( value ), static_cast< off_t >( index ) );
+        if ( rd == sizeof( value ) )
+            return msr_ok;
+
+        value = 0;
+
+        // The driver turns a faulting rdmsr into EIO; anything else is an access problem.
+        //
+        return ( rd < 0 && errno == EIO ) ? msr_gp_fault : msr_no_access;
+    }
+
+    private:
+    int get_fd( uint32_t cpu )
+    {
+        if ( cpu >= cpu_count )
+            return fd_unavailable;
+
+        int fd = fds[ cpu ].load( std::memory_order_acquire );
+        if ( fd != fd_unopened )
+            return fd;
+
+        // Back off after a failed open; a sweep would otherwise retry it once per register.
+        //
+        const int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+        if ( now < retry_at[ cpu ].load( std::memory_order_relaxed ) )
+            return fd_unavailable;
+
+        char path[ 32 ];
+        snprintf( path, sizeof( path ), "/dev/cpu/%u/msr", cpu );
+
+        const int opened = open( path, O_RDONLY | O_CLOEXEC );
+        if ( opened < 0 )
+        {
+            const auto retry = std::chrono::steady_clock::now() + open_retry_interval;
+            retry_at[ cpu ].store( retry.time_since_epoch().count(), std::memory_order_relaxed );
+            return fd_unavailable;
+        }
+
+        int expected = fd_unopened;
+        if ( !fds[ cpu ].compare_exchange_strong( expected, opened, std::memory_order_acq_rel ) )
+        {
+            close( opened );
+            return expected;
+        }
+
+        return opened;
+    }
+
+    uint32_t cpu_count;
+    std::unique_ptr<std::atomic<int>[]> fds;
+    std::unique_ptr<std::atomic<int64_t>[]> retry_at;     // steady_clock ticks; no open before this
+};
+
+using native_msr_backend = dev_msr_backend;
+
+#endif
+
+inline msr_backend& native_msr_source()
+{
+    static native_msr_backend backend;
+    return backend;
+}
+
+inline msr_backend* active_msr_backend = nullptr;
+
+// Not synchronized; install alternate backends before any queries are issued.
+//
+inline void set_msr_backend( msr_backend* backend ) { active_msr_backend = backend; }
+
+inline msr_backend& get_msr_backend()
+{
+    return active_msr_backend ? *active_msr_backend : native_msr_source();
+}
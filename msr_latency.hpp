@@ -0,0 +1,124 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "cpu_affinity.hpp"
+#include "latency_histogram.hpp"
+#include "msr_sweep.hpp"
+#include "tsc.hpp"
+
+// Read latency of one MSR on one cpu, in TSC cycles. Faulting reads are timed as well, since
+// the #GP path is what a probe of a missing register costs.
+//
+struct msr_latency
+{
+    uint32_t index;
+    e_msr_status status;
+    latency_summary cycles;
+};
+
+struct msr_latency_result
+{
+    uint32_t cpu;
+    std::vector<msr_latency> records;   // ascending by index
+    latency_histogram ok_reads;         // every sample of an index that read successfully
+    latency_histogram faulted_reads;    // every sample of an index that #GP'd
+};
+
+// Reads each swept index samples times on every requested cpu, one pinned worker per cpu as in
+// sweep_msrs, and times each read with serialized TSC reads. Each index is read once untimed
+// first; indices that cannot be read at all (no access) are recorded without timing. A cpu that
+// cannot be pinned comes back with no records.
+//
+inline std::vector<msr_latency_result> profile_msr_latency( const msr_sweep_options& options = {}, std::size_t samples = 16, msr_backend& backend = get_msr_backend() )
+{
+    const auto indices = msr_sweep_indices( options );
+    std::vector<msr_latency_result> results( options.cpus.size() );
+    for ( std::size_t slot = 0; slot < results.size(); ++slot )
+        results[ slot ].cpu = options.cpus[ slot ];
+
+    for_each_cpu_parallel( options.cpus, [ & ] ( std::size_t slot, uint32_t cpu )
+    {
+        auto& result = results[ slot ];
+        result.records.reserve( indices.size() );
+
+        // Measured on the worker so it reflects the cpu being profiled.
+        //
+        const uint64_t overhead = tsc_overhead();
+        std::vector<uint64_t> cycles( samples ? samples : 1 );
+
+        for ( const auto index : indices )
+        {
+            uint64_t value;
+            e_msr_status status = backend.read( cpu, index, value );
+            if ( status == msr_no_access )
+            {
+                result.records.push_back( { index, status, {} } );
+                continue;
+            }
+
+            for ( auto& sample : cycles )
+            {
+                const uint64_t start = tsc_begin();
+                status = backend.read( cpu, index, value );
+                const uint64_t elapsed = tsc_end() - start;
+
+                sample = elapsed > overhead ? elapsed - overhead : 0;
+            }
+
+            auto& histogram = status == msr_ok ? result.ok_reads : result.faulted_reads;
+            for ( const auto sample : cycles )
+                histogram.record( sample );
+
+            result.records.push_back( { index, status, summarize_latency( cycles ) } );
+        }
+    } );
+
+    return results;
+}
+
+// Indices whose median read latency is more than factor times the median of all reads with the
+// same outcome -- the registers to keep out of high-frequency telemetry.
+//
+inline std::vector<msr_latency> msr_latency_outliers( const msr_latency_result& result, double factor = 4.0 )
+{
+    const uint64_t ok_median = result.ok_reads.value_at( 50.0 );
+    const uint64_t faulted_median = result.faulted_reads.value_at( 50.0 );
+
+    std::vector<msr_latency> outliers;
+    for ( const auto& record : result.records )
+    {
+        if ( record.status == msr_no_access )
+            continue;
+
+        const uint64_t baseline = record.status == msr_ok ? ok_median : faulted_median;
+        if ( double( record.cycles.median ) > factor * double( baseline ) )
+            outliers.push_back( record );
+    }
+
+    return outliers;
+}
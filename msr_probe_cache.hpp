@@ -0,0 +1,179 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cpu_affinity.hpp"
+#include "cpuid.hpp"
+#include "msr_backend.hpp"
+#include "msr_schema.hpp"
+
+constexpr uint32_t ia32_bios_sign_id = 0x8b;
+
+// Identifies a processor + microcode combination. Any change here can change which MSRs
+// exist, so probe results are only reused while the signature matches exactly.
+//
+struct cpu_signature
+{
+    uint32_t version = 0;       // cpuid.01h:eax, stepping/model/family
+    uint32_t microcode = 0;     // ia32_bios_sign_id[63:32]
+
+    bool operator==( const cpu_signature& other ) const = default;
+
+    // Without the microcode revision a microcode update would go unnoticed, so an incomplete
+    // signature never matches a saved map.
+    //
+    [[nodiscard]] bool complete() const { return version != 0 && microcode != 0; }
+};
+
+// Both halves come from cpu: leaf 1 and the IA32_BIOS_SIGN_ID read are issued on a worker
+// pinned to it, CPUID through the raw instruction so an installed cpuid_cache cannot answer for
+// another cpu. A backend that ignores the cpu (the MSVC intrinsic) then still reads the right one.
+// microcode stays 0 if the MSR cannot be read, and both halves do if cpu cannot be pinned; see
+// complete().
+//
+inline cpu_signature read_cpu_signature( uint32_t cpu = 0, msr_backend& backend = get_msr_backend(), cpuid_backend& cpuid_source = native_cpuid_source )
+{
+    cpu_signature signature;
+    for_each_cpu_parallel( { cpu }, [ & ] ( std::size_t, uint32_t )
+    {
+        signature.version = static_cast< uint32_t >( cpu_query( 1, 0, cpuid_source ).get_by_name( "eax" ) );
+
+        uint64_t sign_id = 0;
+        if ( backend.read( cpu, ia32_bios_sign_id, sign_id ) == msr_ok )
+            signature.microcode = static_cast< uint32_t >( sign_id >> 32 );
+    } );
+
+    return signature;
+}
+
+// Bitmap over the dense MSR slot space of indices known to #GP on every cpu of a machine
+// with a given signature. Schema-known indices are never skipped, even if they faulted.
+//
+struct msr_probe_map
+{
+    static constexpr char file_magic[ 8 ] = { 'A', 'E', 'P', 'R', 'O', 'B', 'E', '\0' };
+    static constexpr uint32_t file_version = 1;
+
+    struct file_header
+    {
+        char magic[ 8 ];
+        uint32_t version;
+        uint32_t slot_count;
+        cpu_signature signature;
+    };
+
+    cpu_signature signature;
+    std::vector<uint8_t> faulted = std::vector<uint8_t>( ( msr_slot_count + 7 ) / 8 );
+
+    msr_probe_map() = default;
+    explicit msr_probe_map( const cpu_signature& signature ) : signature( signature ) {}
+
+    [[nodiscard]] bool is_faulted( uint32_t index ) const
+    {
+        const uint32_t slot = msr_index_to_slot( index );
+        return slot != msr_invalid_slot && ( faulted[ slot / 8 ] >> ( slot % 8 ) ) & 1;
+    }
+
+    void set_faulted( uint32_t index, bool value )
+    {
+        const uint32_t slot = msr_index_to_slot( index );
+        if ( slot == msr_invalid_slot )
+            return;
+
+        const uint8_t mask = uint8_t( 1 ) << ( slot % 8 );
+        faulted[ slot / 8 ] = value ? ( faulted[ slot / 8 ] | mask ) : ( faulted[ slot / 8 ] & ~mask );
+    }
+
+    [[nodiscard]] bool should_skip( uint32_t index ) const
+    {
+        return is_faulted( index ) && !msr_schema_known( index );
+    }
+
+    [[nodiscard]] std::size_t faulted_count() const
+    {
+        std::size_t count = 0;
+        for ( const auto byte : faulted )
+            for ( auto bits = byte; bits; bits &= bits - 1 )
+                ++count;
+        return count;
+    }
+
+    // Loads a previously saved map. Returns false and leaves an empty map for `current` when
+    // the file is missing, malformed, or was recorded under a different or incomplete signature.
+    //
+    bool load( const std::string& path, const cpu_signature& current )
+    {
+        *this = msr_probe_map( current );
+        if ( !current.complete() )
+            return false;
+
+        std::ifstream in( path, std::ios::binary );
+        if ( !in )
+            return false;
+
+        file_header header{};
+        if ( !in.read( reinterpret_cast< char* >( &header ), sizeof( header ) ) )
+            return false;
+
+        if ( std::memcmp( header.magic, file_magic, sizeof( file_magic ) ) != 0 ||
+             header.version != file_version ||
+             header.slot_count != msr_slot_count ||
+             !( header.signature == current ) )
+            return false;
+
+        std::vector<uint8_t> bits( faulted.size() );
+        if ( !in.read( reinterpret_cast< char* >( bits.data() ), static_cast< std::streamsize >( bits.size() ) ) )
+            return false;
+
+        faulted = std::move( bits );
+        return true;
+    }
+
+    // A map under an incomplete signature could never be loaded again, so it is not written.
+    //
+    bool save( const std::string& path ) const
+    {
+        if ( !signature.complete() )
+            return false;
+
+        std::ofstream out( path, std::ios::binary | std::ios::trunc );
+        if ( !out )
+            return false;
+
+        file_header header{};
+        std::memcpy( header.magic, file_magic, sizeof( file_magic ) );
+        header.version = file_version;
+        header.slot_count = msr_slot_count;
+        header.signature = signature;
+
+        out.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+        out.write( reinterpret_cast< const char* >( faulted.data() ), static_cast< std::streamsize >( faulted.size() ) );
+        return static_cast< bool >( out );
+    }
+};
@@ -0,0 +1,219 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+#include "cpu_affinity.hpp"
+#include "msr.hpp"
+#include "msr_probe_cache.hpp"
+
+struct msr_range
+{
+    uint32_t first;
+    uint32_t last;      // inclusive
+};
+
+// The address ranges covered by the reports in demo_logs.
+//
+inline constexpr std::array<msr_range, 3> msr_sweep_ranges = { {
+    { 0, valid_msr_range_end },
+    { reserved_msr_range_start, reserved_msr_range_end },
+    { valid_msr_range_start2, valid_msr_range_end2 },
+} };
+
+struct msr_record
+{
+    uint32_t index;
+    e_msr_status status;
+    uint64_t value;
+};
+
+struct msr_sweep_result
+{
+    uint32_t cpu;
+    std::vector<msr_record> records;    // ascending by index
+};
+
+struct msr_sweep_table
+{
+    std::vector<msr_sweep_result> cpus; // ascending by cpu
+
+    [[nodiscard]] const msr_sweep_result* find_cpu( uint32_t cpu ) const
+    {
+        const auto it = std::ranges::lower_bound( cpus, cpu, {}, &msr_sweep_result::cpu );
+        return ( it != cpus.end() && it->cpu == cpu ) ? &*it : nullptr;
+    }
+
+    [[nodiscard]] const msr_record* find( uint32_t cpu, uint32_t index ) const
+    {
+        const auto* result = find_cpu( cpu );
+        if ( !result )
+            return nullptr;
+
+        const auto it = std::ranges::lower_bound( result->records, index, {}, &msr_record::index );
+        return ( it != result->records.end() && it->index == index ) ? &*it : nullptr;
+    }
+};
+
+struct msr_sweep_options
+{
+    std::vector<msr_range> ranges{ msr_sweep_ranges.begin(), msr_sweep_ranges.end() };
+    std::vector<uint32_t> cpus = online_cpus();
+
+    // Only touch indices that have an entry in msr_schema_list, instead of every index in ranges.
+    //
+    bool schema_only = false;
+
+    // Indices this map knows to #GP are reported as msr_gp_fault without being read.
+    //
+    const msr_probe_map* probe_map = nullptr;
+};
+
+// Sorted, de-duplicated list of indices a sweep with these options will read.
+//
+inline std::vector<uint32_t> msr_sweep_indices( const msr_sweep_options& options )
+{
+    std::vector<uint32_t> indices;
+
+    if ( options.schema_only )
+    {
+        for ( const auto index : msr_schema_list | std::views::keys )
+            indices.push_back( index );
+    }
+    else
+    {
+        for ( const auto& range : options.ranges )
+            for ( uint64_t index = range.first; index <= range.last; ++index )
+                indices.push_back( static_cast< uint32_t >( index ) );
+    }
+
+    std::ranges::sort( indices );
+    const auto dupes = std::ranges::unique( indices );
+    indices.erase( dupes.begin(), dupes.end() );
+    return indices;
+}
+
+// Reads every index on every requested cpu at once, one worker pinned to each cpu, and
+// merges the per-cpu results into a single table. Workers only ever write their own slot. A cpu
+// whose worker could not be pinned reports every index as msr_no_access.
+//
+inline msr_sweep_table sweep_msrs( const msr_sweep_options& options = {}, msr_backend& backend = get_msr_backend() )
+{
+    const auto indices = msr_sweep_indices( options );
+
+    msr_sweep_table table;
+    table.cpus.resize( options.cpus.size() );
+
+    const auto pinned = for_each_cpu_parallel( options.cpus, [ & ] ( std::size_t slot, uint32_t cpu )
+    {
+        auto& result = table.cpus[ slot ];
+        result.cpu = cpu;
+        result.records.resize( indices.size() );
+
+        for ( std::size_t i = 0; i < indices.size(); ++i )
+        {
+            auto& record = result.records[ i ];
+            record.index = indices[ i ];
+
+            if ( options.probe_map && options.probe_map->should_skip( record.index ) )
+            {
+                record.status = msr_gp_fault;
+                record.value = 0;
+                continue;
+            }
+
+            record.status = backend.read( cpu, record.index, record.value );
+        }
+    } );
+
+    for ( std::size_t slot = 0; slot < pinned.size(); ++slot )
+    {
+        if ( pinned[ slot ] )
+            continue;
+
+        auto& result = table.cpus[ slot ];
+        result.cpu = options.cpus[ slot ];
+        for ( const auto index : indices )
+            result.records.push_back( { index, msr_no_access, 0 } );
+    }
+
+    std::ranges::sort( table.cpus, {}, &msr_sweep_result::cpu );
+    return table;
+}
+
+// Folds a sweep into a probe map: an index is marked faulted only if it #GP'd on every cpu in
+// the table, and cleared as soon as any cpu reads it. Indices with no usable result are left alone,
+// and so are indices the map itself skips: their msr_gp_fault records came from the map, not
+// from a read.
+//
+inline void update_probe_map( msr_probe_map& map, const msr_sweep_table& table )
+{
+    if ( table.cpus.empty() )
+        return;
+
+    const auto& first = table.cpus.front().records;
+    for ( std::size_t i = 0; i < first.size(); ++i )
+    {
+        const uint32_t index = first[ i ].index;
+        bool any_ok = false;
+        bool all_faulted = true;
+
+        for ( const auto& cpu : table.cpus )
+        {
+            const auto status = cpu.records[ i ].status;
+            any_ok |= status == msr_ok;
+            all_faulted &= status == msr_gp_fault;
+        }
+
+        if ( any_ok )
+            map.set_faulted( index, false );
+        else if ( all_faulted && !map.should_skip( index ) )
+            map.set_faulted( index, true );
+    }
+}
+
+// Sweep that reuses and refreshes a persisted probe map. The map is discarded automatically if
+// the cpu signature (cpuid.01h:eax + microcode revision) has changed since it was saved. An empty
+// cpu list sweeps every online cpu.
+//
+inline msr_sweep_table sweep_msrs_cached( const std::string& probe_path, msr_sweep_options options = {},
+                                          msr_backend& backend = get_msr_backend() )
+{
+    if ( options.cpus.empty() )
+        options.cpus = online_cpus();
+
+    msr_probe_map map;
+    map.load( probe_path, read_cpu_signature( options.cpus.front(), backend ) );
+
+    options.probe_map = &map;
+    auto table = sweep_msrs( options, backend );
+
+    update_probe_map( map, table );
+    map.save( probe_path );
+    return table;
+}
@@ -0,0 +1,196 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "cpu_affinity.hpp"
+#include "msr_backend.hpp"
+#include "spsc_ring.hpp"
+#include "tsc.hpp"
+
+struct msr_sample
+{
+    uint64_t tsc;           // read just before the RDMSR, on the sampled cpu
+    uint32_t index;
+    uint32_t status;        // e_msr_status
+    uint64_t value;
+};
+
+// ia32_perf_status, ia32_therm_status, ia32_package_therm_status, ia32_mperf, ia32_aperf
+//
+inline constexpr uint32_t default_watch_msrs[] = { 0x198, 0x19c, 0x1b1, 0xe7, 0xe8 };
+
+struct msr_watch_options
+{
+    std::vector<uint32_t> msrs{ std::begin( default_watch_msrs ), std::end( default_watch_msrs ) };
+    std::vector<uint32_t> cpus = online_cpus();
+
+    // Time between the starts of two rounds over msrs on one cpu; 1 kHz by default. A round that
+    // overruns starts the next one immediately rather than bursting to catch up.
+    //
+    std::chrono::nanoseconds interval = std::chrono::microseconds( 1000 );
+};
+
+// Samples a fixed MSR set on every cpu at a fixed rate. Each cpu gets its own pinned sampler
+// thread that calls the backend directly (no msr_query, no schema lookups) and pushes raw
+// (tsc, index, value) samples into that cpu's spsc_ring; one collector thread calls drain().
+//
+// A register that #GPs is sampled once, so the collector sees why, and then dropped from that
+// cpu's set. If the backend has no access to a cpu at all its sampler stops after one round.
+// Samples pushed into a full ring are counted as dropped, never blocked on.
+//
+struct msr_watch
+{
+    static constexpr std::size_t ring_capacity = 1 << 14;
+
+    using sample_ring = spsc_ring<msr_sample, ring_capacity>;
+
+    explicit msr_watch( msr_watch_options options = {}, msr_backend& backend = get_msr_backend() )
+        : options( std::move( options ) ), backend( backend )
+    {
+        for ( const auto cpu : this->options.cpus )
+        {
+            auto state = std::make_unique<cpu_state>();
+            state->cpu = cpu;
+            cpus.push_back( std::move( state ) );
+        }
+    }
+
+    msr_watch( const msr_watch& ) = delete;
+    msr_watch& operator=( const msr_watch& ) = delete;
+
+    ~msr_watch() { stop(); }
+
+    void start()
+    {
+        if ( running.exchange( true ) )
+            return;
+
+        for ( auto& state : cpus )
+        {
+            state->active.store( true, std::memory_order_relaxed );
+            samplers.emplace_back( [ this, cpu = state.get() ] { sample( *cpu ); } );
+        }
+    }
+
+    void stop()
+    {
+        running.store( false );
+        for ( auto& sampler : samplers )
+            sampler.join();
+        samplers.clear();
+    }
+
+    // Collector side; must only be called from one thread at a time. fn( cpu, const msr_sample& )
+    // sees each cpu's samples in order. Returns the number of samples consumed.
+    //
+    template <typename Fn>
+    std::size_t drain( Fn&& fn )
+    {
+        std::size_t total = 0;
+        for ( auto& state : cpus )
+            total += state->ring.drain( [ & ] ( const msr_sample& s ) { fn( state->cpu, s ); } );
+        return total;
+    }
+
+    [[nodiscard]] uint64_t dropped() const
+    {
+        uint64_t total = 0;
+        for ( const auto& state : cpus )
+            total += state->dropped.load( std::memory_order_relaxed );
+        return total;
+    }
+
+    [[nodiscard]] bool sampling() const
+    {
+        for ( const auto& state : cpus )
+            if ( state->active.load( std::memory_order_relaxed ) )
+                return true;
+        return false;
+    }
+
+    private:
+    struct cpu_state
+    {
+        uint32_t cpu = 0;
+        std::atomic<uint64_t> dropped{ 0 };
+        std::atomic<bool> active{ false };
+        sample_ring ring;
+    };
+
+    void sample( cpu_state& state )
+    {
+        if ( !pin_current_thread( state.cpu ) )
+        {
+            state.active.store( false, std::memory_order_relaxed );
+            return;
+        }
+
+        std::vector<uint32_t> msrs = options.msrs;
+        auto next = std::chrono::steady_clock::now();
+
+        while ( running.load( std::memory_order_relaxed ) && !msrs.empty() )
+        {
+            bool no_access = false;
+            std::size_t kept = 0;
+
+            for ( const auto index : msrs )
+            {
+                msr_sample s{ __rdtsc(), index, msr_ok, 0 };
+                s.status = backend.read( state.cpu, index, s.value );
+
+                if ( !state.ring.try_push( s ) )
+                    state.dropped.fetch_add( 1, std::memory_order_relaxed );
+
+                no_access |= s.status == msr_no_access;
+                if ( s.status != msr_gp_fault )
+                    msrs[ kept++ ] = index;
+            }
+
+            msrs.resize( no_access ? 0 : kept );
+
+            next += options.interval;
+            const auto now = std::chrono::steady_clock::now();
+            if ( next < now )
+                next = now;
+            else
+                std::this_thread::sleep_until( next );
+        }
+
+        state.active.store( false, std::memory_order_relaxed );
+    }
+
+    msr_watch_options options;
+    msr_backend& backend;
+    std::vector<std::unique_ptr<cpu_state>> cpus;
+    std::vector<std::thread> samplers;
+    std::atomic<bool> running{ false };
+};
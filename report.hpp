@@ -0,0 +1,254 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "cpuid.hpp"
+#include "field_decode.hpp"
+#include "msr.hpp"
+#include "msr_sweep.hpp"
+
+// Formats reports into one reusable buffer and hands it to stdio in large writes. Padding comes
+// from static runs of spaces/dashes instead of per-line temporaries, and numbers are converted
+// by hand, so a full report costs a memcpy per token rather than a printf per line.
+//
+struct report_writer
+{
+    static constexpr std::size_t default_capacity = 1 << 20;
+
+    explicit report_writer( FILE* out, std::size_t capacity = default_capacity )
+        : out( out ), owned( capacity < 256 ? 256 : capacity ), data( owned.data() ), capacity( owned.size() )
+    {
+    }
+
+    // Formats into caller-provided storage, e.g. a stack buffer for a single short report.
+    //
+    template <std::size_t N>
+    report_writer( FILE* out, char( &buffer )[ N ] ) : out( out ), data( buffer ), capacity( N )
+    {
+        static_assert( N >= 256 );
+    }
+
+    report_writer( const report_writer& ) = delete;
+    report_writer& operator=( const report_writer& ) = delete;
+
+    ~report_writer() { flush(); }
+
+    void flush()
+    {
+        if ( used )
+            fwrite( data, 1, used, out );
+        used = 0;
+    }
+
+    report_writer& put( std::string_view text )
+    {
+        if ( text.size() > capacity - used )
+        {
+            flush();
+            if ( text.size() > capacity )
+            {
+                fwrite( text.data(), 1, text.size(), out );
+                return *this;
+            }
+        }
+
+        std::memcpy( data + used, text.data(), text.size() );
+        used += text.size();
+        return *this;
+    }
+
+    report_writer& put( char c )
+    {
+        if ( used == capacity )
+            flush();
+
+        data[ used++ ] = c;
+        return *this;
+    }
+
+    report_writer& repeat( char c, std::size_t count )
+    {
+        static constexpr std::string_view spaces = "                                                                                                                                ";
+        static constexpr std::string_view dashes = "--------------------------------------------------------------------------------------------------------------------------------";
+
+        const std::string_view run = c == '-' ? dashes : spaces;
+        if ( c != ' ' && c != '-' )
+        {
+            while ( count-- )
+                put( c );
+            return *this;
+        }
+
+        while ( count )
+        {
+            const std::size_t n = count < run.size() ? count : run.size();
+            put( run.substr( 0, n ) );
+            count -= n;
+        }
+
+        return *this;
+    }
+
+    // printf's %*s and %-*s: pad to width, never truncate.
+    //
+    report_writer& right( std::string_view text, std::size_t width )
+    {
+        if ( text.size() < width )
+            repeat( ' ', width - text.size() );
+        return put( text );
+    }
+
+    report_writer& left( std::string_view text, std::size_t width )
+    {
+        put( text );
+        return text.size() < width ? repeat( ' ', width - text.size() ) : *this;
+    }
+
+    // %llX
+    //
+    report_writer& hex( uint64_t value )
+    {
+        char digits[ 16 ];
+        std::size_t n = 0;
+        do
+        {
+            digits[ 15 - n++ ] = "0123456789ABCDEF"[ value & 0xf ];
+            value >>= 4;
+        } while ( value );
+
+        return put( std::string_view( digits + 16 - n, n ) );
+    }
+
+    // %llu, as a view into scratch so it can be aligned with right()/left().
+    //
+    static std::string_view dec( uint64_t value, char( &scratch )[ 20 ] )
+    {
+        std::size_t n = 0;
+        do
+        {
+            scratch[ 19 - n++ ] = static_cast< char >( '0' + value % 10 );
+            value /= 10;
+        } while ( value );
+
+        return { scratch + 20 - n, n };
+    }
+
+    report_writer& dec( uint64_t value )
+    {
+        char scratch[ 20 ];
+        return put( dec( value, scratch ) );
+    }
+
+    private:
+    FILE* out;
+    std::vector<char> owned;
+    char* data;
+    std::size_t capacity;
+    std::size_t used = 0;
+};
+
+// "%70s {%5llu:%-5llu} %15s %llXh\n"
+//
+template <typename Field>
+void write_field_line( report_writer& writer, const Field& field, uint64_t value )
+{
+    char start[ 20 ], end[ 20 ];
+    writer.right( field.name, 70 ).put( " {" )
+          .right( report_writer::dec( field.bit_start, start ), 5 ).put( ':' )
+          .left( report_writer::dec( field.bit_end, end ), 5 ).put( "} " )
+          .right( "=", 15 ).put( ' ' ).hex( value ).put( "h\n" );
+}
+
+// Text reports in the layout of the demo logs: one block per CPUID leaf, and the .lxx execution
+// report for an MSR sweep of one cpu.
+//
+inline void write_cpuid( report_writer& writer, cpu_query& cpuid )
+{
+    writer.put( "## CPUID [" ).hex( static_cast< uint32_t >( cpuid.function_id() ) ).put( '.' )
+          .hex( static_cast< uint32_t >( cpuid.subfunction_id() ) ).put( "]\n" );
+
+    if ( cpuid.get_schema().empty() )
+        writer.repeat( ' ', 15 ).put( " |=> LEAF DOES NOT EXIST / INVALID / UNSUPPORTED\n" );
+
+    for ( auto& [name, idx] : cpuid.get_schema() )
+    {
+        const auto reg_value = static_cast< uint32_t >( cpuid[ name ].data );
+        writer.repeat( ' ', 15 ).put( '[' ).put( name ).put( "] {" ).hex( reg_value ).put( "h}\n" );
+
+        const auto values = decode_register( reg_value, idx.fields );
+        for ( std::size_t i = 0; i < values.size(); ++i )
+            write_field_line( writer, idx.fields[ i ], values[ i ] );
+    }
+    // don't judge
+    writer.put( '\n' ).repeat( '-', 128 ).put( "\n\n" );
+}
+
+inline void write_msr_report( report_writer& writer, const msr_sweep_result& result )
+{
+    writer.put( "[[EXECUTION REPORT]]\n## CPU [" ).dec( result.cpu ).put( "]\n" );
+
+    for ( const auto& record : result.records )
+    {
+        if ( record.status == msr_gp_fault )
+        {
+            writer.repeat( ' ', 15 ).put( "[ " ).hex( record.index ).put( " ] #GP(0)\n" );
+            continue;
+        }
+
+        if ( record.status == msr_no_access )
+        {
+            writer.repeat( ' ', 15 ).put( "[ " ).hex( record.index ).put( " ] NO ACCESS\n" );
+            continue;
+        }
+
+        for ( auto& [name, schema] : find_msr_schema( record.index ) )
+        {
+            writer.repeat( ' ', 15 ).put( '[' ).put( name ).put( " | " ).hex( record.index ).put( "] {" ).hex( record.value ).put( "h}\n" );
+
+            const auto values = decode_register( record.value, schema.fields );
+            for ( std::size_t i = 0; i < values.size(); ++i )
+                write_field_line( writer, schema.fields[ i ], values[ i ] );
+            break;
+        }
+    }
+}
+
+inline void print_cpuid( cpu_query& cpuid, FILE* out = stdout )
+{
+    char buffer[ 16384 ];
+    report_writer writer( out, buffer );
+    write_cpuid( writer, cpuid );
+}
+
+inline void print_msr_report( const msr_sweep_result& result, FILE* out = stdout )
+{
+    report_writer writer( out );
+    write_msr_report( writer, result );
+}
@@ -0,0 +1,185 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+// Building blocks for the constexpr CPUID/MSR schema tables. Everything here is a literal type
+// so the tables are emitted as read-only data with no dynamic initialization.
+//
+
+// Every schema name is a string literal, so data() is NUL-terminated and c_str() is safe.
+//
+struct schema_string : std::string_view
+{
+    constexpr schema_string() = default;
+    constexpr schema_string( const char* s ) : std::string_view( s ) {}
+
+    [[nodiscard]] constexpr const char* c_str() const { return data(); }
+};
+
+// String literal usable as a template argument, e.g. cpuid_field_ref<0x1, "eax", "family">.
+//
+template <std::size_t N>
+struct fixed_string
+{
+    char value[ N ]{};
+
+    constexpr fixed_string( const char( &s )[ N ] )
+    {
+        for ( std::size_t i = 0; i < N; ++i )
+            value[ i ] = s[ i ];
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const { return { value, N - 1 }; }
+};
+
+// In-place mask of bits [bit_start, bit_end]; bits past 63 are dropped and inverted ranges are empty.
+//
+constexpr uint64_t field_mask( std::size_t bit_start, std::size_t bit_end )
+{
+    if ( bit_start > 63 || bit_end < bit_start )
+        return 0;
+
+    const std::size_t len = ( bit_end > 63 ? 63 : bit_end ) - bit_start + 1;
+    return ( len == 64 ? ~uint64_t( 0 ) : ( ( uint64_t( 1 ) << len ) - 1 ) ) << bit_start;
+}
+
+// Small fixed-capacity name -> schema map with std::unordered_map's read-only surface.
+//
+template <typename Schema, std::size_t Capacity>
+struct schema_map
+{
+    using value_type = std::pair<schema_string, Schema>;
+
+    std::array<value_type, Capacity> entries{};
+    std::size_t count = 0;
+
+    constexpr schema_map() = default;
+    constexpr schema_map( std::initializer_list<value_type> init )
+    {
+        if ( init.size() > Capacity )
+            throw std::length_error( "schema_map capacity exceeded" );
+
+        for ( const auto& entry : init )
+            entries[ count++ ] = entry;
+    }
+
+    [[nodiscard]] constexpr const value_type* begin() const { return entries.data(); }
+    [[nodiscard]] constexpr const value_type* end() const { return entries.data() + count; }
+    [[nodiscard]] constexpr std::size_t size() const { return count; }
+    [[nodiscard]] constexpr bool empty() const { return count == 0; }
+
+    [[nodiscard]] constexpr const value_type* find( std::string_view name ) const
+    {
+        for ( const auto& entry : *this )
+            if ( entry.first == name )
+                return &entry;
+        return end();
+    }
+
+    [[nodiscard]] constexpr bool contains( std::string_view name ) const { return find( name ) != end(); }
+
+    [[nodiscard]] constexpr const Schema& at( std::string_view name ) const
+    {
+        const auto* entry = find( name );
+        if ( entry == end() )
+            throw std::out_of_range( "schema_map::at" );
+        return entry->second;
+    }
+
+    // Unknown names yield an empty schema, as the old unordered_map::operator[] did.
+    //
+    [[nodiscard]] constexpr const Schema& operator[]( std::string_view name ) const
+    {
+        const auto* entry = find( name );
+        return entry != end() ? entry->second : empty_schema;
+    }
+
+    static constexpr Schema empty_schema{};
+};
+
+// Sorted uint32_t -> schema table, searched with a binary search.
+//
+template <typename Value, std::size_t N>
+struct schema_index
+{
+    using value_type = std::pair<uint32_t, Value>;
+
+    std::array<value_type, N> entries{};
+    std::size_t count = 0;
+
+    [[nodiscard]] constexpr const value_type* begin() const { return entries.data(); }
+    [[nodiscard]] constexpr const value_type* end() const { return entries.data() + count; }
+    [[nodiscard]] constexpr std::size_t size() const { return count; }
+
+    [[nodiscard]] constexpr const value_type* find( uint32_t key ) const
+    {
+        std::size_t lo = 0, hi = count;
+        while ( lo < hi )
+        {
+            const std::size_t mid = ( lo + hi ) / 2;
+            if ( entries[ mid ].first < key )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        return ( lo < count && entries[ lo ].first == key ) ? &entries[ lo ] : end();
+    }
+
+    [[nodiscard]] constexpr bool contains( uint32_t key ) const { return find( key ) != end(); }
+};
+
+// Sorts the entries by key at compile time. If a key is listed twice the first entry wins,
+// which is what the unordered_map initializer these tables replaced did.
+//
+template <typename Value, std::size_t N>
+consteval schema_index<Value, N> make_schema_index( const std::pair<uint32_t, Value>( &init )[ N ] )
+{
+    schema_index<Value, N> index;
+
+    for ( const auto& entry : init )
+    {
+        std::size_t pos = 0;
+        while ( pos < index.count && index.entries[ pos ].first < entry.first )
+            ++pos;
+
+        if ( pos < index.count && index.entries[ pos ].first == entry.first )
+            continue;
+
+        for ( std::size_t i = index.count; i > pos; --i )
+            index.entries[ i ] = index.entries[ i - 1 ];
+
+        index.entries[ pos ] = entry;
+        ++index.count;
+    }
+
+    return index;
+}
@@ -0,0 +1,379 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "cpu_affinity.hpp"
+#include "cpuid.hpp"
+#include "mapped_file.hpp"
+#include "msr_sweep.hpp"
+
+// On-disk snapshot of a whole machine: CPUID leaves and MSR values for every logical cpu.
+//
+// Layout (native byte order, every section 8-byte aligned, offsets from the start of the file):
+//
+//   snapshot_header
+//   snapshot_cpu[ cpu_count ]          ascending by cpu
+//   msr_range[ range_count ]           ranges the MSR sweep covered
+//   snapshot_cpuid[ cpuid_count ]      grouped by cpu, ascending by (leaf, subleaf)
+//   snapshot_msr[ msr_count ]          grouped by cpu, ascending by index
+//
+// MSRs that #GP'd inside a swept range are not stored: an index that falls inside a range but
+// has no record faulted, which is what keeps a snapshot a small fraction of the .lxx text. All records
+// are fixed-width, so a mapped file is used in place and looked up with binary search.
+//
+constexpr char snapshot_magic[ 8 ] = { 'A', 'E', 'S', 'N', 'A', 'P', '\0', '\0' };
+constexpr uint32_t snapshot_version = 1;
+
+// Records are written and mapped as-is, so the file is only little-endian because the host is.
+//
+static_assert( std::endian::native == std::endian::little, "snapshots are stored in native byte order" );
+
+struct snapshot_header
+{
+    char magic[ 8 ];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t cpu_count;
+    uint32_t range_count;
+    uint32_t cpuid_count;
+    uint32_t msr_count;
+    uint64_t cpu_offset;
+    uint64_t range_offset;
+    uint64_t cpuid_offset;
+    uint64_t msr_offset;
+};
+
+struct snapshot_cpu
+{
+    uint32_t cpu;
+    uint32_t reserved;
+    uint32_t cpuid_first;
+    uint32_t cpuid_count;
+    uint32_t msr_first;
+    uint32_t msr_count;
+};
+
+struct snapshot_cpuid
+{
+    uint32_t leaf;
+    uint32_t subleaf;
+    uint32_t regs[ 4 ];     // eax, ebx, ecx, edx
+};
+
+struct snapshot_msr
+{
+    uint32_t index;
+    uint32_t status;        // e_msr_status; msr_gp_fault only for indices outside every range
+    uint64_t value;
+};
+
+static_assert( sizeof( snapshot_header ) == 64 );
+static_assert( sizeof( snapshot_cpu ) == 24 );
+static_assert( sizeof( msr_range ) == 8 );
+static_assert( sizeof( snapshot_cpuid ) == 24 );
+static_assert( sizeof( snapshot_msr ) == 16 );
+
+// Result of looking an MSR up in a snapshot; msr_not_swept means the index was outside every
+// range the sweep covered, so nothing is known about it.
+//
+constexpr uint32_t msr_not_swept = 0xffffffff;
+
+struct snapshot_msr_lookup
+{
+    uint32_t status;
+    uint64_t value;
+};
+
+struct snapshot_builder
+{
+    struct cpu_data
+    {
+        uint32_t cpu;
+        std::vector<snapshot_cpuid> cpuid;
+        std::vector<snapshot_msr> msrs;
+    };
+
+    std::vector<cpu_data> cpus;
+    std::vector<msr_range> ranges;
+
+    cpu_data& get_cpu( uint32_t cpu )
+    {
+        const auto it = std::ranges::lower_bound( cpus, cpu, {}, &cpu_data::cpu );
+        if ( it != cpus.end() && it->cpu == cpu )
+            return *it;
+
+        return *cpus.insert( it, cpu_data{ cpu, {}, {} } );
+    }
+
+    void add_cpuid( uint32_t cpu, const cpu_query& query )
+    {
+        snapshot_cpuid record{};
+        record.leaf = static_cast< uint32_t >( query.function_id() );
+        record.subleaf = static_cast< uint32_t >( query.subfunction_id() );
+        std::memcpy( record.regs, query.registers(), sizeof( record.regs ) );
+        get_cpu( cpu ).cpuid.push_back( record );
+    }
+
+    void add_msr_sweep( const msr_sweep_table& table, std::span<const msr_range> swept )
+    {
+        ranges.assign( swept.begin(), swept.end() );
+
+        const auto implied = [ & ] ( const msr_record& record )
+        {
+            return record.status == msr_gp_fault &&
+                std::ranges::any_of( ranges, [ & ] ( const msr_range& r ) { return record.index >= r.first && record.index <= r.last; } );
+        };
+
+        for ( const auto& result : table.cpus )
+        {
+            auto& data = get_cpu( result.cpu );
+            for ( const auto& record : result.records )
+                if ( !implied( record ) )
+                    data.msrs.push_back( { record.index, static_cast< uint32_t >( record.status ), record.value } );
+        }
+    }
+
+    [[nodiscard]] std::vector<std::byte> serialize()
+    {
+        std::size_t cpuid_total = 0;
+        std::size_t msr_total = 0;
+
+        for ( auto& data : cpus )
+        {
+            std::ranges::sort( data.cpuid, {}, [] ( const snapshot_cpuid& r ) { return std::tie( r.leaf, r.subleaf ); } );
+            std::ranges::sort( data.msrs, {}, &snapshot_msr::index );
+            cpuid_total += data.cpuid.size();
+            msr_total += data.msrs.size();
+        }
+
+        const auto align = [] ( std::size_t v ) { return ( v + 7 ) & ~std::size_t( 7 ); };
+
+        snapshot_header header{};
+        std::memcpy( header.magic, snapshot_magic, sizeof( snapshot_magic ) );
+        header.version = snapshot_version;
+        header.header_size = sizeof( snapshot_header );
+        header.cpu_count = static_cast< uint32_t >( cpus.size() );
+        header.range_count = static_cast< uint32_t >( ranges.size() );
+        header.cpuid_count = static_cast< uint32_t >( cpuid_total );
+        header.msr_count = static_cast< uint32_t >( msr_total );
+        header.cpu_offset = align( sizeof( snapshot_header ) );
+        header.range_offset = align( header.cpu_offset + cpus.size() * sizeof( snapshot_cpu ) );
+        header.cpuid_offset = align( header.range_offset + ranges.size() * sizeof( msr_range ) );
+        header.msr_offset = align( header.cpuid_offset + cpuid_total * sizeof( snapshot_cpuid ) );
+
+        std::vector<std::byte> out( header.msr_offset + msr_total * sizeof( snapshot_msr ) );
+        std::memcpy( out.data(), &header, sizeof( header ) );
+
+        if ( !ranges.empty() )
+            std::memcpy( out.data() + header.range_offset, ranges.data(), ranges.size() * sizeof( msr_range ) );
+
+        uint32_t cpuid_first = 0;
+        uint32_t msr_first = 0;
+
+        for ( std::size_t i = 0; i < cpus.size(); ++i )
+        {
+            const auto& data = cpus[ i ];
+
+            snapshot_cpu entry{};
+            entry.cpu = data.cpu;
+            entry.cpuid_first = cpuid_first;
+            entry.cpuid_count = static_cast< uint32_t >( data.cpuid.size() );
+            entry.msr_first = msr_first;
+            entry.msr_count = static_cast< uint32_t >( data.msrs.size() );
+            std::memcpy( out.data() + header.cpu_offset + i * sizeof( snapshot_cpu ), &entry, sizeof( entry ) );
+
+            if ( !data.cpuid.empty() )
+                std::memcpy( out.data() + header.cpuid_offset + cpuid_first * sizeof( snapshot_cpuid ),
+                             data.cpuid.data(), data.cpuid.size() * sizeof( snapshot_cpuid ) );
+            if ( !data.msrs.empty() )
+                std::memcpy( out.data() + header.msr_offset + msr_first * sizeof( snapshot_msr ),
+                             data.msrs.data(), data.msrs.size() * sizeof( snapshot_msr ) );
+
+            cpuid_first += entry.cpuid_count;
+            msr_first += entry.msr_count;
+        }
+
+        return out;
+    }
+
+    bool write( const std::string& path )
+    {
+        const auto bytes = serialize();
+
+        std::ofstream out( path, std::ios::binary | std::ios::trunc );
+        out.write( reinterpret_cast< const char* >( bytes.data() ), static_cast< std::streamsize >( bytes.size() ) );
+        return static_cast< bool >( out );
+    }
+};
+
+// Zero-parse view over serialized snapshot bytes (typically a mapped_file). The view does not
+// own the bytes. valid() is false if the header or any section falls outside the buffer.
+//
+struct snapshot_view
+{
+    snapshot_view() = default;
+
+    explicit snapshot_view( std::span<const std::byte> bytes )
+    {
+        if ( bytes.size() < sizeof( snapshot_header ) || reinterpret_cast< uintptr_t >( bytes.data() ) % 8 )
+            return;
+
+        const auto* header = reinterpret_cast< const snapshot_header* >( bytes.data() );
+        if ( std::memcmp( header->magic, snapshot_magic, sizeof( snapshot_magic ) ) != 0 ||
+             header->version != snapshot_version ||
+             header->header_size != sizeof( snapshot_header ) )
+            return;
+
+        const auto section_ok = [ & ] ( uint64_t offset, uint64_t count, std::size_t size )
+        {
+            return offset % 8 == 0 && offset <= bytes.size() && count <= ( bytes.size() - offset ) / size;
+        };
+
+        if ( !section_ok( header->cpu_offset, header->cpu_count, sizeof( snapshot_cpu ) ) ||
+             !section_ok( header->range_offset, header->range_count, sizeof( msr_range ) ) ||
+             !section_ok( header->cpuid_offset, header->cpuid_count, sizeof( snapshot_cpuid ) ) ||
+             !section_ok( header->msr_offset, header->msr_count, sizeof( snapshot_msr ) ) )
+            return;
+
+        const auto* base = bytes.data();
+        cpus = { reinterpret_cast< const snapshot_cpu* >( base + header->cpu_offset ), header->cpu_count };
+        ranges = { reinterpret_cast< const msr_range* >( base + header->range_offset ), header->range_count };
+        cpuid = { reinterpret_cast< const snapshot_cpuid* >( base + header->cpuid_offset ), header->cpuid_count };
+        msrs = { reinterpret_cast< const snapshot_msr* >( base + header->msr_offset ), header->msr_count };
+
+        for ( const auto& entry : cpus )
+            if ( entry.cpuid_first > cpuid.size() || entry.cpuid_count > cpuid.size() - entry.cpuid_first ||
+                 entry.msr_first > msrs.size() || entry.msr_count > msrs.size() - entry.msr_first )
+                return;
+
+        ok = true;
+    }
+
+    [[nodiscard]] bool valid() const { return ok; }
+
+    [[nodiscard]] const snapshot_cpu* find_cpu( uint32_t cpu ) const
+    {
+        const auto it = std::ranges::lower_bound( cpus, cpu, {}, &snapshot_cpu::cpu );
+        return ( it != cpus.end() && it->cpu == cpu ) ? &*it : nullptr;
+    }
+
+    [[nodiscard]] std::span<const snapshot_cpuid> cpuid_of( const snapshot_cpu& entry ) const
+    {
+        return cpuid.subspan( entry.cpuid_first, entry.cpuid_count );
+    }
+
+    [[nodiscard]] std::span<const snapshot_msr> msrs_of( const snapshot_cpu& entry ) const
+    {
+        return msrs.subspan( entry.msr_first, entry.msr_count );
+    }
+
+    [[nodiscard]] const snapshot_cpuid* find_cpuid( uint32_t cpu, uint32_t leaf, uint32_t subleaf ) const
+    {
+        const auto* entry = find_cpu( cpu );
+        if ( !entry )
+            return nullptr;
+
+        const auto records = cpuid_of( *entry );
+        const auto key = std::tie( leaf, subleaf );
+        const auto it = std::ranges::lower_bound( records, key, {}, [] ( const snapshot_cpuid& r ) { return std::tie( r.leaf, r.subleaf ); } );
+        return ( it != records.end() && it->leaf == leaf && it->subleaf == subleaf ) ? &*it : nullptr;
+    }
+
+    [[nodiscard]] bool swept( uint32_t index ) const
+    {
+        return std::ranges::any_of( ranges, [ index ] ( const msr_range& r ) { return index >= r.first && index <= r.last; } );
+    }
+
+    [[nodiscard]] snapshot_msr_lookup find_msr( uint32_t cpu, uint32_t index ) const
+    {
+        if ( const auto* entry = find_cpu( cpu ) )
+        {
+            const auto records = msrs_of( *entry );
+            const auto it = std::ranges::lower_bound( records, index, {}, &snapshot_msr::index );
+            if ( it != records.end() && it->index == index )
+                return { it->status, it->value };
+        }
+
+        return { swept( index ) ? uint32_t( msr_gp_fault ) : msr_not_swept, 0 };
+    }
+
+    std::span<const snapshot_cpu> cpus;
+    std::span<const msr_range> ranges;
+    std::span<const snapshot_cpuid> cpuid;
+    std::span<const snapshot_msr> msrs;
+
+    private:
+    bool ok = false;
+};
+
+// Mapped snapshot file plus its view; keeps the mapping alive for as long as the view is used.
+//
+struct snapshot_file
+{
+    mapped_file file;
+    snapshot_view view;
+
+    explicit snapshot_file( const std::string& path ) : file( path ), view( file.bytes() ) {}
+
+    [[nodiscard]] bool valid() const { return view.valid(); }
+};
+
+// Captures every cpu: CPUID leaves are issued from a worker pinned to each cpu, then the MSR
+// ranges in options are swept across all of them. A cpu that cannot be pinned is stored with no
+// CPUID leaves and every MSR as no access. CPUID defaults to the raw instruction rather than
+// get_cpuid_backend(), so every leaf is executed on the cpu it is recorded for instead of being
+// served from an installed cpuid_cache.
+//
+inline snapshot_builder capture_snapshot( const msr_sweep_options& options = {}, msr_backend& backend = get_msr_backend(), cpuid_backend& cpuid_source = native_cpuid_source )
+{
+    snapshot_builder builder;
+    std::vector<std::vector<snapshot_cpuid>> per_cpu( options.cpus.size() );
+
+    for_each_cpu_parallel( options.cpus, [ & ] ( std::size_t slot, uint32_t )
+    {
+        for_each_cpuid_leaf( [ & ] ( cpu_query& leaf )
+        {
+            snapshot_cpuid record{};
+            record.leaf = static_cast< uint32_t >( leaf.function_id() );
+            record.subleaf = static_cast< uint32_t >( leaf.subfunction_id() );
+            std::memcpy( record.regs, leaf.registers(), sizeof( record.regs ) );
+            per_cpu[ slot ].push_back( record );
+        }, cpuid_source );
+    } );
+
+    for ( std::size_t slot = 0; slot < options.cpus.size(); ++slot )
+        builder.get_cpu( options.cpus[ slot ] ).cpuid = std::move( per_cpu[ slot ] );
+
+    builder.add_msr_sweep( sweep_msrs( options, backend ), options.schema_only ? std::span<const msr_range>{} : std::span<const msr_range>( options.ranges ) );
+    return builder;
+}
@@ -0,0 +1,262 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "cpuid.hpp"
+#include "field_decode.hpp"
+#include "msr.hpp"
+#include "snapshot.hpp"
+
+enum e_diff_kind
+{
+    diff_added = 0,
+    diff_removed = 1,
+    diff_changed = 2
+};
+
+// Named field whose value differs between the two sides of a changed register.
+//
+struct field_change
+{
+    std::string_view name;
+    uint32_t bit_start;
+    uint32_t bit_end;
+    uint64_t before;
+    uint64_t after;
+};
+
+struct cpuid_change
+{
+    uint32_t cpu;
+    uint32_t leaf;
+    uint32_t subleaf;
+    e_cpuid_registers reg;
+    e_diff_kind kind;
+    uint32_t before;
+    uint32_t after;
+    uint32_t field_first;       // into snapshot_diff::fields
+    uint32_t field_count;
+};
+
+struct msr_change
+{
+    uint32_t cpu;
+    uint32_t index;
+    e_diff_kind kind;
+    snapshot_msr_lookup before;
+    snapshot_msr_lookup after;
+    uint32_t field_first;       // into snapshot_diff::fields
+    uint32_t field_count;
+};
+
+struct snapshot_diff
+{
+    std::vector<cpuid_change> cpuid;
+    std::vector<msr_change> msrs;
+    std::vector<field_change> fields;
+
+    [[nodiscard]] bool empty() const { return cpuid.empty() && msrs.empty(); }
+
+    [[nodiscard]] std::span<const field_change> fields_of( const cpuid_change& change ) const
+    {
+        return std::span( fields ).subspan( change.field_first, change.field_count );
+    }
+
+    [[nodiscard]] std::span<const field_change> fields_of( const msr_change& change ) const
+    {
+        return std::span( fields ).subspan( change.field_first, change.field_count );
+    }
+};
+
+// Single-pass merge walk over two snapshots. Both sides are already sorted by cpu and then by
+// (leaf, subleaf) / index, so the whole diff is O(n) with one schema lookup per changed register.
+//
+struct snapshot_differ
+{
+    const snapshot_view& a;
+    const snapshot_view& b;
+    snapshot_diff out;
+
+    template <typename Field>
+    void diff_fields( std::span<const Field> schema_fields, uint64_t before, uint64_t after, uint32_t& first, uint32_t& count )
+    {
+        first = static_cast< uint32_t >( out.fields.size() );
+
+        const auto old_values = decode_register( before, schema_fields );
+        const auto new_values = decode_register( after, schema_fields );
+
+        for ( std::size_t i = 0; i < old_values.size(); ++i )
+        {
+            const auto& field = schema_fields[ i ];
+            if ( field.bit_end < field.bit_start || field.bit_start >= 64 )
+                continue;
+
+            const auto old_value = old_values[ i ];
+            const auto new_value = new_values[ i ];
+            if ( old_value != new_value )
+                out.fields.push_back( { field.name, static_cast< uint32_t >( field.bit_start ),
+                                        static_cast< uint32_t >( field.bit_end ), old_value, new_value } );
+        }
+
+        count = static_cast< uint32_t >( out.fields.size() ) - first;
+    }
+
+    void add_cpuid( uint32_t cpu, const snapshot_cpuid* before, const snapshot_cpuid* after )
+    {
+        const auto& leaf = before ? *before : *after;
+        const auto kind = !before ? diff_added : !after ? diff_removed : diff_changed;
+        const auto& schema = find_cpuid_schema( static_cast< int32_t >( leaf.leaf ), static_cast< int32_t >( leaf.subleaf ) );
+
+        for ( uint32_t reg = 0; reg < 4; ++reg )
+        {
+            const uint32_t old_value = before ? before->regs[ reg ] : 0;
+            const uint32_t new_value = after ? after->regs[ reg ] : 0;
+            if ( kind == diff_changed && old_value == new_value )
+                continue;
+
+            cpuid_change change{ cpu, leaf.leaf, leaf.subleaf, static_cast< e_cpuid_registers >( reg ), kind, old_value, new_value, 0, 0 };
+
+            const auto reg_schema = schema.find( cpu_query::to_string( change.reg ) );
+            if ( kind == diff_changed && reg_schema != schema.end() )
+                diff_fields( reg_schema->second.fields, old_value, new_value, change.field_first, change.field_count );
+            else
+                change.field_first = static_cast< uint32_t >( out.fields.size() );
+
+            out.cpuid.push_back( change );
+        }
+    }
+
+    void add_msr( uint32_t cpu, uint32_t index, const snapshot_msr_lookup& before, const snapshot_msr_lookup& after )
+    {
+        const bool had = before.status == msr_ok;
+        const bool has = after.status == msr_ok;
+
+        if ( before.status == after.status && before.value == after.value )
+            return;
+
+        msr_change change{ cpu, index, diff_changed, before, after, static_cast< uint32_t >( out.fields.size() ), 0 };
+
+        if ( had && has )
+        {
+            for ( const auto& schema : find_msr_schema( index ) | std::views::values )
+            {
+                diff_fields( schema.fields, before.value, after.value, change.field_first, change.field_count );
+                break;
+            }
+        }
+        else if ( has )
+            change.kind = diff_added;
+        else if ( had )
+            change.kind = diff_removed;
+
+        out.msrs.push_back( change );
+    }
+
+    void diff_cpu( uint32_t cpu, const snapshot_cpu* left, const snapshot_cpu* right )
+    {
+        const auto lc = left ? a.cpuid_of( *left ) : std::span<const snapshot_cpuid>{};
+        const auto rc = right ? b.cpuid_of( *right ) : std::span<const snapshot_cpuid>{};
+
+        for ( std::size_t i = 0, j = 0; i < lc.size() || j < rc.size(); )
+        {
+            const auto key = [] ( const snapshot_cpuid& r ) { return ( uint64_t( r.leaf ) << 32 ) | r.subleaf; };
+
+            if ( j == rc.size() || ( i < lc.size() && key( lc[ i ] ) < key( rc[ j ] ) ) )
+                add_cpuid( cpu, &lc[ i++ ], nullptr );
+            else if ( i == lc.size() || key( rc[ j ] ) < key( lc[ i ] ) )
+                add_cpuid( cpu, nullptr, &rc[ j++ ] );
+            else
+            {
+                if ( std::memcmp( lc[ i ].regs, rc[ j ].regs, sizeof( lc[ i ].regs ) ) != 0 )
+                    add_cpuid( cpu, &lc[ i ], &rc[ j ] );
+                ++i, ++j;
+            }
+        }
+
+        // Absent records are implied #GP (or unswept) on that side; resolve through the view
+        // so both sides compare the same way. A cpu missing from one snapshot was never captured
+        // there, so all of its MSRs are unswept on that side rather than #GP.
+        //
+        const auto lm = left ? a.msrs_of( *left ) : std::span<const snapshot_msr>{};
+        const auto rm = right ? b.msrs_of( *right ) : std::span<const snapshot_msr>{};
+        const auto implied = [] ( const snapshot_view& view, const snapshot_cpu* entry, uint32_t index ) -> snapshot_msr_lookup
+        {
+            return { entry && view.swept( index ) ? uint32_t( msr_gp_fault ) : msr_not_swept, 0 };
+        };
+
+        for ( std::size_t i = 0, j = 0; i < lm.size() || j < rm.size(); )
+        {
+            if ( j == rm.size() || ( i < lm.size() && lm[ i ].index < rm[ j ].index ) )
+            {
+                add_msr( cpu, lm[ i ].index, { lm[ i ].status, lm[ i ].value }, implied( b, right, lm[ i ].index ) );
+                ++i;
+            }
+            else if ( i == lm.size() || rm[ j ].index < lm[ i ].index )
+            {
+                add_msr( cpu, rm[ j ].index, implied( a, left, rm[ j ].index ), { rm[ j ].status, rm[ j ].value } );
+                ++j;
+            }
+            else
+            {
+                add_msr( cpu, lm[ i ].index, { lm[ i ].status, lm[ i ].value }, { rm[ j ].status, rm[ j ].value } );
+                ++i, ++j;
+            }
+        }
+    }
+
+    void run()
+    {
+        for ( std::size_t i = 0, j = 0; i < a.cpus.size() || j < b.cpus.size(); )
+        {
+            if ( j == b.cpus.size() || ( i < a.cpus.size() && a.cpus[ i ].cpu < b.cpus[ j ].cpu ) )
+            {
+                diff_cpu( a.cpus[ i ].cpu, &a.cpus[ i ], nullptr );
+                ++i;
+            }
+            else if ( i == a.cpus.size() || b.cpus[ j ].cpu < a.cpus[ i ].cpu )
+            {
+                diff_cpu( b.cpus[ j ].cpu, nullptr, &b.cpus[ j ] );
+                ++j;
+            }
+            else
+            {
+                diff_cpu( a.cpus[ i ].cpu, &a.cpus[ i ], &b.cpus[ j ] );
+                ++i, ++j;
+            }
+        }
+    }
+};
+
+inline snapshot_diff diff_snapshots( const snapshot_view& before, const snapshot_view& after )
+{
+    snapshot_differ differ{ before, after, {} };
+    differ.run();
+    return std::move( differ.out );
+}
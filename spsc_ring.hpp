@@ -0,0 +1,109 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread. Indices grow
+// without wrapping and are masked on access, so full/empty never need a spare slot. Each side
+// keeps the other's index cached and only reloads it when the ring looks full/empty, which keeps
+// the shared cache lines from bouncing on every push.
+//
+template <typename T, std::size_t Capacity>
+struct spsc_ring
+{
+    static_assert( Capacity && ( Capacity & ( Capacity - 1 ) ) == 0, "capacity must be a power of two" );
+    static_assert( std::is_trivially_copyable_v<T> );
+
+    static constexpr std::size_t capacity = Capacity;
+
+    // Producer only. Returns false, leaving the ring untouched, if it is full.
+    //
+    bool try_push( const T& item )
+    {
+        const uint64_t head = write_index.load( std::memory_order_relaxed );
+        if ( head - cached_read_index >= Capacity )
+        {
+            cached_read_index = read_index.load( std::memory_order_acquire );
+            if ( head - cached_read_index >= Capacity )
+                return false;
+        }
+
+        slots[ head & ( Capacity - 1 ) ] = item;
+        write_index.store( head + 1, std::memory_order_release );
+        return true;
+    }
+
+    // Consumer only.
+    //
+    bool try_pop( T& item )
+    {
+        const uint64_t tail = read_index.load( std::memory_order_relaxed );
+        if ( tail == cached_write_index )
+        {
+            cached_write_index = write_index.load( std::memory_order_acquire );
+            if ( tail == cached_write_index )
+                return false;
+        }
+
+        item = slots[ tail & ( Capacity - 1 ) ];
+        read_index.store( tail + 1, std::memory_order_release );
+        return true;
+    }
+
+    // Consumer only. Hands everything published so far to fn( const T& ) and releases the slots in
+    // one store at the end; returns how many items were consumed.
+    //
+    template <typename Fn>
+    std::size_t drain( Fn&& fn )
+    {
+        const uint64_t tail = read_index.load( std::memory_order_relaxed );
+        cached_write_index = write_index.load( std::memory_order_acquire );
+
+        for ( uint64_t i = tail; i != cached_write_index; ++i )
+            fn( slots[ i & ( Capacity - 1 ) ] );
+
+        read_index.store( cached_write_index, std::memory_order_release );
+        return static_cast< std::size_t >( cached_write_index - tail );
+    }
+
+    // Approximate unless called from one of the two sides while the other is idle.
+    //
+    [[nodiscard]] std::size_t size() const
+    {
+        return static_cast< std::size_t >( write_index.load( std::memory_order_acquire ) - read_index.load( std::memory_order_acquire ) );
+    }
+
+    private:
+    alignas( 64 ) std::atomic<uint64_t> write_index{ 0 };
+    uint64_t cached_read_index = 0;                 // producer's copy
+
+    alignas( 64 ) std::atomic<uint64_t> read_index{ 0 };
+    uint64_t cached_write_index = 0;                // consumer's copy
+
+    alignas( 64 ) std::array<T, Capacity> slots{};
+};
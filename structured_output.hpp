@@ -0,0 +1,264 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#include "cpu_affinity.hpp"
+#include "cpuid.hpp"
+#include "field_decode.hpp"
+#include "msr.hpp"
+#include "msr_sweep.hpp"
+#include "report.hpp"
+#include "snapshot.hpp"
+
+enum e_record_format
+{
+    record_ndjson = 0,
+    record_csv = 1
+};
+
+// Streams CPUID and MSR results as machine-readable records straight into a report_writer; no
+// record is built in memory, each column goes out as it is formatted.
+//
+// NDJSON: one object per register, decoded schema fields as an array (names are not unique
+// within a register, e.g. "reserved"). Every number is an unsigned decimal.
+//
+//   {"type":"cpuid","cpu":0,"leaf":7,"subleaf":0,"register":"ebx","value":..,"fields":[{"name":"fsgsbase","bit_start":0,"bit_end":0,"value":1},..]}
+//   {"type":"msr","cpu":0,"index":16,"register":"ia32_time_stamp_counter","status":"ok","value":..,"fields":[..]}
+//
+// An MSR whose status is not "ok" was never read: its value is null in NDJSON and empty in CSV.
+//
+// CSV: the same records flattened to one row per decoded field, so registers repeat their
+// columns; a register without a schema is a single row with empty field columns. Schema names
+// are plain identifiers, so nothing needs quoting.
+//
+struct record_emitter
+{
+    static constexpr std::string_view csv_header = "type,cpu,leaf,subleaf,index,register,status,value,field,bit_start,bit_end,field_value\n";
+
+    record_emitter( report_writer& writer, e_record_format format ) : writer( writer ), format( format )
+    {
+        if ( format == record_csv )
+            writer.put( csv_header );
+    }
+
+    // All four registers of a leaf, in eax..edx order, whether or not the leaf has a schema.
+    //
+    void cpuid( uint32_t cpu, uint32_t leaf, uint32_t subleaf, const uint32_t( &regs )[ 4 ] )
+    {
+        const auto& schema = find_cpuid_schema( static_cast< int32_t >( leaf ), static_cast< int32_t >( subleaf ) );
+        for ( int reg = eax; reg <= edx; ++reg )
+        {
+            const std::string_view name = cpu_query::to_string( static_cast< e_cpuid_registers >( reg ) );
+            const auto prefix = [ & ]
+            {
+                text( "type", "cpuid" );
+                number( "cpu", cpu );
+                number( "leaf", leaf );
+                number( "subleaf", subleaf );
+                skip();
+                text( "register", name );
+                skip();
+            };
+
+            emit( prefix, true, regs[ reg ], schema[ name ].fields );
+        }
+    }
+
+    void cpuid( uint32_t cpu, const cpu_query& query )
+    {
+        uint32_t regs[ 4 ];
+        std::memcpy( regs, query.registers(), sizeof( regs ) );
+        cpuid( cpu, static_cast< uint32_t >( query.function_id() ), static_cast< uint32_t >( query.subfunction_id() ), regs );
+    }
+
+    // status is an e_msr_status; registers that could not be read carry no value or fields.
+    //
+    void msr( uint32_t cpu, uint32_t index, uint32_t status, uint64_t value )
+    {
+        const auto& schema = find_msr_schema( index );
+        const std::string_view name = schema.empty() ? std::string_view{} : std::string_view( schema.begin()->first );
+        const auto prefix = [ & ]
+        {
+            text( "type", "msr" );
+            number( "cpu", cpu );
+            skip();
+            skip();
+            number( "index", index );
+            text( "register", name );
+            text( "status", status == msr_ok ? "ok" : status == msr_gp_fault ? "gp_fault" : "no_access" );
+        };
+
+        if ( status != msr_ok )
+            emit( prefix, false, 0, std::span<const msr_field>{} );
+        else if ( schema.empty() )
+            emit( prefix, true, value, std::span<const msr_field>{} );
+        else
+            emit( prefix, true, value, schema.begin()->second.fields );
+    }
+
+    private:
+    template <typename Prefix, typename Field>
+    void emit( const Prefix& prefix, bool has_value, uint64_t value, std::span<const Field> fields )
+    {
+        const auto values = decode_register( value, fields );
+
+        if ( format == record_ndjson )
+        {
+            first = true;
+            writer.put( '{' );
+            prefix();
+            if ( has_value )
+                number( "value", value );
+            else
+                null( "value" );
+            writer.put( ",\"fields\":[" );
+            for ( std::size_t i = 0; i < values.size(); ++i )
+            {
+                writer.put( i ? ",{\"name\":\"" : "{\"name\":\"" ).put( fields[ i ].name )
+                      .put( "\",\"bit_start\":" ).dec( fields[ i ].bit_start )
+                      .put( ",\"bit_end\":" ).dec( fields[ i ].bit_end )
+                      .put( ",\"value\":" ).dec( values[ i ] ).put( '}' );
+            }
+            writer.put( "]}\n" );
+            return;
+        }
+
+        const auto row = [ & ]
+        {
+            first = true;
+            prefix();
+            if ( has_value )
+                number( "value", value );
+            else
+                null( "value" );
+        };
+
+        if ( values.size() == 0 )
+        {
+            row();
+            writer.put( ",,,,\n" );
+            return;
+        }
+
+        for ( std::size_t i = 0; i < values.size(); ++i )
+        {
+            row();
+            writer.put( ',' ).put( fields[ i ].name ).put( ',' ).dec( fields[ i ].bit_start )
+                  .put( ',' ).dec( fields[ i ].bit_end ).put( ',' ).dec( values[ i ] ).put( '\n' );
+        }
+    }
+
+    // NDJSON writes "key":value and drops absent columns; CSV writes the value alone and keeps an
+    // empty column so every row lines up with csv_header.
+    //
+    void key( std::string_view name )
+    {
+        if ( !first )
+            writer.put( ',' );
+        first = false;
+
+        if ( format == record_ndjson )
+            writer.put( '"' ).put( name ).put( "\":" );
+    }
+
+    void number( std::string_view name, uint64_t value )
+    {
+        key( name );
+        writer.dec( value );
+    }
+
+    void text( std::string_view name, std::string_view value )
+    {
+        key( name );
+        if ( format == record_ndjson )
+            writer.put( '"' ).put( value ).put( '"' );
+        else
+            writer.put( value );
+    }
+
+    void null( std::string_view name )
+    {
+        key( name );
+        if ( format == record_ndjson )
+            writer.put( "null" );
+    }
+
+    void skip()
+    {
+        if ( format == record_csv )
+        {
+            writer.put( ',' );
+            first = false;
+        }
+    }
+
+    report_writer& writer;
+    e_record_format format;
+    bool first = true;
+};
+
+// Registers that #GP'd are left out, as in snapshots: a sweep reports one for nearly every index
+// in its ranges and they carry no value.
+//
+inline void emit_msr_sweep( record_emitter& emitter, const msr_sweep_table& table )
+{
+    for ( const auto& result : table.cpus )
+        for ( const auto& record : result.records )
+            if ( record.status != msr_gp_fault )
+                emitter.msr( result.cpu, record.index, record.status, record.value );
+}
+
+inline void emit_snapshot( record_emitter& emitter, const snapshot_view& snapshot )
+{
+    for ( const auto& entry : snapshot.cpus )
+    {
+        for ( const auto& record : snapshot.cpuid_of( entry ) )
+            emitter.cpuid( entry.cpu, record.leaf, record.subleaf, record.regs );
+
+        for ( const auto& record : snapshot.msrs_of( entry ) )
+            emitter.msr( entry.cpu, record.index, record.status, record.value );
+    }
+}
+
+// Live capture without the intermediate snapshot: each cpu's CPUID leaves are streamed from a
+// worker pinned to that cpu, one cpu at a time so records stay grouped, then the MSR ranges are
+// swept and streamed. The caller's affinity is left alone. CPUID defaults to the raw instruction,
+// as in capture_snapshot, and a cpu that cannot be pinned gets no CPUID records.
+//
+inline void emit_live( record_emitter& emitter, const msr_sweep_options& options = {}, msr_backend& backend = get_msr_backend(), cpuid_backend& cpuid_source = native_cpuid_source )
+{
+    for ( const auto cpu : options.cpus )
+    {
+        for_each_cpu_parallel( { cpu }, [ & ] ( std::size_t, uint32_t )
+        {
+            for_each_cpuid_leaf( [ & ] ( cpu_query& leaf ) { emitter.cpuid( cpu, leaf ); }, cpuid_source );
+        } );
+    }
+
+    emit_msr_sweep( emitter, sweep_msrs( options, backend ) );
+}
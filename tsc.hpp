@@ -0,0 +1,94 @@
+/* This project is licensed under the MIT license. See the LICENSE file for more details.
+ *
+ * Copyright 2023. Derek (Daax) Rynd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+// Serialized TSC reads for timing a short code region:
+//
+//     const uint64_t start = tsc_begin();
+//     ...
+//     const uint64_t cycles = tsc_end() - start;
+//
+// LFENCE keeps earlier instructions from drifting into the region, and RDTSCP + LFENCE keeps the
+// region's instructions from drifting past the end.
+//
+inline uint64_t tsc_begin()
+{
+    _mm_lfence();
+    const uint64_t tsc = __rdtsc();
+    _mm_lfence();
+    return tsc;
+}
+
+inline uint64_t tsc_end()
+{
+    unsigned int aux;
+    const uint64_t tsc = __rdtscp( &aux );
+    _mm_lfence();
+    return tsc;
+}
+
+// Cost of an empty tsc_begin/tsc_end pair; subtracted from measurements.
+//
+inline uint64_t tsc_overhead()
+{
+    uint64_t best = ~uint64_t( 0 );
+    for ( int i = 0; i < 1000; ++i )
+    {
+        const uint64_t start = tsc_begin();
+        best = std::min( best, tsc_end() - start );
+    }
+
+    return best;
+}
+
+struct latency_summary
+{
+    uint64_t min = 0;
+    uint64_t median = 0;
+    uint64_t p99 = 0;
+    uint64_t max = 0;
+};
+
+// Sorts samples in place.
+//
+inline latency_summary summarize_latency( std::vector<uint64_t>& samples )
+{
+    if ( samples.empty() )
+        return {};
+
+    std::sort( samples.begin(), samples.end() );
+
+    const std::size_t n = samples.size();
+    return { samples.front(), samples[ n / 2 ], samples[ std::min( n - 1, n * 99 / 100 ) ], samples.back() };
+}